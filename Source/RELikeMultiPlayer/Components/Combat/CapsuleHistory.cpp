@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CapsuleHistory.h"
+
+void FCapsuleHistory::Record(double Time, const FVector& Location, float HalfHeight, float Radius)
+{
+    if (Num > 0 && Time <= GetNewest().Time)
+    {
+        Head = (Head - 1 + Capacity) % Capacity;
+        Num--;
+    }
+
+    FCapsuleSnapshot& Snapshot = Snapshots[Head];
+    Snapshot.Time = Time;
+    Snapshot.Location = Location;
+    Snapshot.HalfHeight = HalfHeight;
+    Snapshot.Radius = Radius;
+
+    Head = (Head + 1) % Capacity;
+    Num = FMath::Min(Num + 1, Capacity);
+}
+
+bool FCapsuleHistory::Rewind(double Time, FCapsuleSnapshot& OutSnapshot) const
+{
+    if (Num == 0 || Time < Get(0).Time) return false;
+
+    if (Time >= GetNewest().Time)
+    {
+        OutSnapshot = GetNewest();
+        return true;
+    }
+
+    // First snapshot at or after Time; the one before it is older than Time
+    int32 Low = 1;
+    int32 High = Num - 1;
+    while (Low < High)
+    {
+        const int32 Mid = (Low + High) / 2;
+        if (Get(Mid).Time < Time)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+
+    const FCapsuleSnapshot& Before = Get(Low - 1);
+    const FCapsuleSnapshot& After = Get(Low);
+    const float Alpha = float((Time - Before.Time) / (After.Time - Before.Time));
+    OutSnapshot.Time = Time;
+    OutSnapshot.Location = FMath::Lerp(Before.Location, After.Location, Alpha);
+    OutSnapshot.HalfHeight = FMath::Lerp(Before.HalfHeight, After.HalfHeight, Alpha);
+    OutSnapshot.Radius = FMath::Lerp(Before.Radius, After.Radius, Alpha);
+    return true;
+}
+
+bool FCapsuleHistory::SegmentHitsCapsule(const FCapsuleSnapshot& Capsule, const FVector& Start, const FVector& End, float Tolerance, FVector& OutHitPoint)
+{
+    // A capsule is every point within Radius of its axis segment
+    const FVector AxisOffset(0.0, 0.0, FMath::Max(Capsule.HalfHeight - Capsule.Radius, 0.0f));
+    FVector AxisPoint;
+    FMath::SegmentDistToSegmentSafe(Start, End, Capsule.Location - AxisOffset, Capsule.Location + AxisOffset, OutHitPoint, AxisPoint);
+    return FVector::DistSquared(OutHitPoint, AxisPoint) <= FMath::Square(Capsule.Radius + Tolerance);
+}
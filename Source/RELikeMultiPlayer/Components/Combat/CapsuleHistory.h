@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+// An upright capsule as it was at Time, in world space
+struct FCapsuleSnapshot
+{
+    double Time = 0.0;
+    FVector Location = FVector::ZeroVector;
+    float HalfHeight = 0.0f;
+    float Radius = 0.0f;
+};
+
+/**
+ * Fixed-size ring of capsule snapshots. Recording overwrites the oldest entry, never allocates,
+ * and is a handful of stores, so every character can record every tick.
+ */
+class RELIKEMULTIPLAYER_API FCapsuleHistory
+{
+public:
+    // About a second at 60Hz. Bounds ULagCompensationComponent::MaxRewindTime.
+    static constexpr int32 Capacity = 64;
+
+    void Reset() { Head = 0; Num = 0; }
+    int32 GetNum() const { return Num; }
+
+    // Snapshot Index 0 is the oldest, GetNum() - 1 the newest
+    const FCapsuleSnapshot& Get(int32 Index) const { return Snapshots[(Head - Num + Index + Capacity) % Capacity]; }
+    const FCapsuleSnapshot& GetNewest() const { return Get(Num - 1); }
+
+    // Times must not go backwards; a second snapshot at the same time replaces the first
+    void Record(double Time, const FVector& Location, float HalfHeight, float Radius);
+
+    // The capsule at Time, interpolated between the snapshots around it. Times after the newest snapshot
+    // return the newest. Fails when the history is empty or Time is older than the oldest snapshot.
+    bool Rewind(double Time, FCapsuleSnapshot& OutSnapshot) const;
+
+    // Whether the segment passes within Tolerance of the capsule, and the closest point on the segment
+    static bool SegmentHitsCapsule(const FCapsuleSnapshot& Capsule, const FVector& Start, const FVector& End, float Tolerance, FVector& OutHitPoint);
+
+private:
+    TStaticArray<FCapsuleSnapshot, Capacity> Snapshots;
+
+    // Next entry to write
+    int32 Head = 0;
+    int32 Num = 0;
+};
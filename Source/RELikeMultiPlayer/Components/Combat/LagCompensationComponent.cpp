@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LagCompensationComponent.h"
+#include "../Health/HealthComponent.h"
+#include "../../Core/Telemetry/GameplayTelemetry.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/GameStateBase.h"
+
+ULagCompensationComponent::ULagCompensationComponent()
+{
+    // Records after movement, on the server only, see BeginPlay
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostPhysics;
+    SetIsReplicatedByDefault(true);
+}
+
+void ULagCompensationComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    Capsule = GetOwner() ? GetOwner()->FindComponentByClass<UCapsuleComponent>() : nullptr;
+    History.Reset();
+
+    if (GetOwnerRole() == ROLE_Authority && Capsule)
+    {
+        SetComponentTickEnabled(true);
+    }
+
+    // The history holds Capacity ticks, so hits older than that would always be rejected as misses.
+    // An uncapped server has no known tick rate, and keeps the configured window.
+    const float TickRate = GEngine ? GEngine->GetMaxTickRate(0.0f, false) : 0.0f;
+    if (TickRate > 0.0f)
+    {
+        const float HistorySeconds = (FCapsuleHistory::Capacity - 1) / TickRate;
+        if (MaxRewindTime > HistorySeconds)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("LagCompensation: %s MaxRewindTime %.2fs is more than the %.2fs the history holds at %.0fHz, clamped"),
+                *GetOwner()->GetName(), MaxRewindTime, HistorySeconds, TickRate);
+            MaxRewindTime = HistorySeconds;
+        }
+    }
+}
+
+void ULagCompensationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    RecordSnapshot(GetWorld()->GetTimeSeconds());
+}
+
+void ULagCompensationComponent::RecordSnapshot(double Time)
+{
+    if (!Capsule) return;
+
+    History.Record(Time, Capsule->GetComponentLocation(), Capsule->GetScaledCapsuleHalfHeight(), Capsule->GetScaledCapsuleRadius());
+}
+
+void ULagCompensationComponent::ConfirmHit(AActor* Target, FVector TraceStart, FVector TraceEnd)
+{
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        // What the client saw happened at its estimate of the server clock
+        const AGameStateBase* GameState = GetWorld()->GetGameState();
+        const double HitTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+        Server_ConfirmHit(Target, TraceStart, TraceEnd, HitTime);
+        return;
+    }
+
+    ProcessHit(Target, TraceStart, TraceEnd, GetWorld()->GetTimeSeconds());
+}
+
+void ULagCompensationComponent::Server_ConfirmHit_Implementation(AActor* Target, FVector_NetQuantize TraceStart, FVector_NetQuantize TraceEnd, double HitTime)
+{
+    ProcessHit(Target, TraceStart, TraceEnd, HitTime);
+}
+
+void ULagCompensationComponent::ProcessHit(AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, double HitTime)
+{
+    if (!Target || Target == GetOwner()) return;
+
+    // Every report counts against the fire rate, valid or not, so flooding the RPC gets nothing through
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (!ConsumeFireBudget(Now))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("LagCompensation: Rejected hit by %s, over %d hits per %.2fs"), *GetOwner()->GetName(), MaxHitsPerFireInterval, FireInterval);
+        RejectHit(Target, EHitRejectReason::FireRate);
+        return;
+    }
+
+    // Never rewind further than MaxRewindTime, or into the future
+    HitTime = FMath::Clamp(HitTime, Now - MaxRewindTime, Now);
+
+    // The shot must start near where the shooter was when firing and stay within range.
+    // Without a capsule the origin cannot be checked, so nothing is accepted.
+    FCapsuleSnapshot Origin;
+    if (!GetShooterCapsuleAt(HitTime, Origin) || FVector::DistSquared(TraceStart, Origin.Location)
+        > FMath::Square(Origin.HalfHeight + MaxTraceOriginError))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("LagCompensation: Rejected hit by %s, trace starts too far from the shooter"), *GetOwner()->GetName());
+        RejectHit(Target, EHitRejectReason::TraceOrigin);
+        return;
+    }
+    if (FVector::DistSquared(TraceStart, TraceEnd) > FMath::Square(MaxTraceLength))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("LagCompensation: Rejected hit by %s, trace longer than %.0f"), *GetOwner()->GetName(), MaxTraceLength);
+        RejectHit(Target, EHitRejectReason::TraceLength);
+        return;
+    }
+
+    if (!ValidateHit(Target, TraceStart, TraceEnd, HitTime))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("LagCompensation: Rejected hit by %s on %s at %.3f"), *GetOwner()->GetName(), *Target->GetName(), HitTime);
+        RejectHit(Target, EHitRejectReason::Missed, float(Now - HitTime));
+        return;
+    }
+
+    if (UHealthComponent* Health = Target->FindComponentByClass<UHealthComponent>())
+    {
+        Health->TakeDamage(HitDamage, GetOwner());
+    }
+}
+
+bool ULagCompensationComponent::GetShooterCapsuleAt(double Time, FCapsuleSnapshot& OutSnapshot) const
+{
+    if (!Capsule) return false;
+
+    if (History.GetNum() == 0)
+    {
+        OutSnapshot.Time = Time;
+        OutSnapshot.Location = Capsule->GetComponentLocation();
+        OutSnapshot.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+        OutSnapshot.Radius = Capsule->GetScaledCapsuleRadius();
+        return true;
+    }
+
+    // Older than the history reaches, the oldest snapshot is the closest there is
+    if (!History.Rewind(Time, OutSnapshot))
+    {
+        OutSnapshot = History.Get(0);
+    }
+    return true;
+}
+
+bool ULagCompensationComponent::ConsumeFireBudget(double Now)
+{
+    if (Now - FireWindowStart >= FireInterval)
+    {
+        FireWindowStart = Now;
+        HitsInFireWindow = 0;
+    }
+    return ++HitsInFireWindow <= MaxHitsPerFireInterval;
+}
+
+void ULagCompensationComponent::RejectHit(AActor* Target, EHitRejectReason Reason, float RewindSeconds) const
+{
+    FGameplayTelemetry::Record(ETelemetryEvent::HitRejected, GetOwner(), Target, RewindSeconds, (int32)Reason);
+}
+
+bool ULagCompensationComponent::ValidateHit(AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, double HitTime) const
+{
+    const ULagCompensationComponent* TargetHistory = Target ? Target->FindComponentByClass<ULagCompensationComponent>() : nullptr;
+    if (!TargetHistory) return false;
+
+    FCapsuleSnapshot Rewound;
+    if (!TargetHistory->History.Rewind(HitTime, Rewound)) return false;
+
+    FVector HitPoint;
+    if (!FCapsuleHistory::SegmentHitsCapsule(Rewound, TraceStart, TraceEnd, HitTolerance, HitPoint)) return false;
+
+    // Static geometry has not moved since the shot, so the current world decides whether it was blocked
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(LagCompensationHit), false);
+    Params.AddIgnoredActor(GetOwner());
+    Params.AddIgnoredActor(Target);
+    return !GetWorld()->LineTraceTestByObjectType(TraceStart, HitPoint, FCollisionObjectQueryParams(ECC_WorldStatic), Params);
+}
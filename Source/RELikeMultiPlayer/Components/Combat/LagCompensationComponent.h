@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CapsuleHistory.h"
+#include "LagCompensationComponent.generated.h"
+
+class UCapsuleComponent;
+
+// Why the server turned a reported hit down, recorded as the Extra of HitRejected telemetry
+enum class EHitRejectReason : int32
+{
+    Missed = 0,         // Missed the rewound capsule, or static geometry was in the way
+    TraceOrigin = 1,    // Trace started away from where the shooter was, or the shooter has no capsule
+    FireRate = 2,       // More hits than the fire interval allows
+    TraceLength = 3     // Trace longer than MaxTraceLength
+};
+
+/**
+ * Server-side hit validation against where targets were when the shooter fired.
+ * On the server every actor with this component records its capsule each tick; a shooter's client reports
+ * a hit with the server time it saw, and the server rewinds the target to that time before checking it.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class RELIKEMULTIPLAYER_API ULagCompensationComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    ULagCompensationComponent();
+
+#if WITH_DEV_AUTOMATION_TESTS
+    friend struct FGameplayTestAccess;
+#endif
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    // Reports a hit on Target by a trace from TraceStart to TraceEnd, fired now.
+    // Clients send it to the server with their estimate of the server time; the server applies HitDamage if it holds up.
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    void ConfirmHit(AActor* Target, FVector TraceStart, FVector TraceEnd);
+
+    // Whether the trace hits Target's capsule as it was at HitTime, with nothing in between. Server only.
+    bool ValidateHit(AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, double HitTime) const;
+
+    // Adds the owner's current capsule to the history, at Time in server world seconds
+    void RecordSnapshot(double Time);
+
+    const FCapsuleHistory& GetHistory() const { return History; }
+
+protected:
+    virtual void BeginPlay() override;
+
+    // Oldest shot the server will rewind for. Hits reported as older are checked at this age.
+    // Limited to what the capsule history holds, FCapsuleHistory::Capacity server ticks: about 1s at 60Hz, 2s at 30Hz.
+    // BeginPlay clamps it to that when the server tick rate is capped.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat|Lag Compensation")
+    float MaxRewindTime = 0.4f;
+
+    // Slack added to the capsule radius for interpolation and quantization error
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat|Lag Compensation")
+    float HitTolerance = 10.0f;
+
+    // How far the trace may start from the shooter's capsule
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat|Lag Compensation")
+    float MaxTraceOriginError = 150.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat|Lag Compensation")
+    float MaxTraceLength = 10000.0f;
+
+    // Server-side fire rate limit: at most MaxHitsPerFireInterval reported hits are considered per FireInterval seconds.
+    // Raise the count for weapons that hit with several pellets per shot.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat|Lag Compensation", meta = (ClampMin = "0.01"))
+    float FireInterval = 0.1f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat|Lag Compensation", meta = (ClampMin = "1"))
+    int32 MaxHitsPerFireInterval = 1;
+
+    // Damage of a confirmed hit, until weapons carry their own
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+    float HitDamage = 25.0f;
+
+private:
+    UPROPERTY()
+    TObjectPtr<UCapsuleComponent> Capsule;
+
+    FCapsuleHistory History;
+
+    // Server: start of the current fire interval and the hits reported in it
+    double FireWindowStart = TNumericLimits<double>::Lowest();
+    int32 HitsInFireWindow = 0;
+
+    // The shooter's capsule at Time, from its own history, or as it is now before anything was recorded
+    bool GetShooterCapsuleAt(double Time, FCapsuleSnapshot& OutSnapshot) const;
+
+    bool ConsumeFireBudget(double Now);
+    void RejectHit(AActor* Target, EHitRejectReason Reason, float RewindSeconds = 0.0f) const;
+
+    void ProcessHit(AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, double HitTime);
+
+    UFUNCTION(Server, Reliable)
+    void Server_ConfirmHit(AActor* Target, FVector_NetQuantize TraceStart, FVector_NetQuantize TraceEnd, double HitTime);
+};
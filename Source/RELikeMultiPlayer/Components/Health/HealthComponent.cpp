@@ -1,4 +1,5 @@
 #include "HealthComponent.h"
+#include "../../Core/Telemetry/GameplayTelemetry.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/Engine.h"
@@ -6,7 +7,10 @@
 
 UHealthComponent::UHealthComponent()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Ticks only while hits are queued
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_LastDemotable;
     SetIsReplicatedByDefault(true);
     
     // Initialize default values
@@ -55,11 +59,18 @@ void UHealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
     Super::EndPlay(EndPlayReason);
 }
 
+void UHealthComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    FlushPendingDamage();
+}
+
 void UHealthComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(UHealthComponent, CurrentHealth);
+    DOREPLIFETIME(UHealthComponent, ReplicatedHealth);
     DOREPLIFETIME(UHealthComponent, CurrentHealthState);
     DOREPLIFETIME(UHealthComponent, bIsDowned);
     
@@ -68,6 +79,7 @@ void UHealthComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 
 void UHealthComponent::OnRep_Health()
 {
+    CurrentHealth = ReplicatedHealth.ToValue(MaxHealth);
     UE_LOG(LogTemp, Log, TEXT("HealthComponent OnRep_Health: %f"), CurrentHealth);
     OnHealthChanged.Broadcast(CurrentHealth);
 }
@@ -81,6 +93,13 @@ void UHealthComponent::OnRep_HealthState()
 
 void UHealthComponent::UpdateHealthState()
 {
+    // A change held back by the threshold is sent once the timer runs out, in case health stops here
+    if (!ReplicatedHealth.Update(CurrentHealth, MaxHealth, ReplicationSteps, ReplicationThreshold) && ReplicationThreshold > 1
+        && GetOwnerRole() == ROLE_Authority && !GetWorld()->GetTimerManager().IsTimerActive(ReplicationSettleTimerHandle))
+    {
+        GetWorld()->GetTimerManager().SetTimer(ReplicationSettleTimerHandle, this, &UHealthComponent::SettleReplicatedHealth, ReplicationSettleDelay, false);
+    }
+
     EHealthState OldState = CurrentHealthState;
 
     if (CurrentHealth <= 0)
@@ -89,11 +108,13 @@ void UHealthComponent::UpdateHealthState()
         {
             bIsDowned = true;
             CurrentHealthState = EHealthState::Downed;
+            FGameplayTelemetry::Record(ETelemetryEvent::Downed, GetOwner());
             Multicast_OnDowned();
         }
         else
         {
             CurrentHealthState = EHealthState::Dead;
+            FGameplayTelemetry::Record(ETelemetryEvent::Died, GetOwner());
             Multicast_OnDied();
         }
     }
@@ -121,6 +142,11 @@ void UHealthComponent::UpdateHealthState()
     }
 }
 
+void UHealthComponent::SettleReplicatedHealth()
+{
+    ReplicatedHealth.Update(CurrentHealth, MaxHealth, ReplicationSteps, 1);
+}
+
 void UHealthComponent::ApplyHealthStateEffects()
 {
     ACharacter* Owner = Cast<ACharacter>(GetOwner());
@@ -159,12 +185,40 @@ void UHealthComponent::ApplyHealthStateEffects()
 
 void UHealthComponent::TakeDamage(float DamageAmount, AActor* DamageCauser)
 {
+    if (CurrentHealthState == EHealthState::Dead) return;
+
+    // Pellets and swarms land many hits a frame, so only the sum is applied and sent
+    PendingDamage += DamageAmount;
+    PendingDamageCauser = DamageCauser;
+    if (PendingHitCount++ == 0)
+    {
+        SetComponentTickEnabled(true);
+    }
+}
+
+void UHealthComponent::FlushPendingDamage()
+{
+    SetComponentTickEnabled(false);
+    if (PendingHitCount == 0) return;
+
+    const float DamageAmount = PendingDamage;
+    const int32 HitCount = PendingHitCount;
+    AActor* DamageCauser = PendingDamageCauser.Get();
+    PendingDamage = 0.0f;
+    PendingHitCount = 0;
+    PendingDamageCauser = nullptr;
+
     if (GetOwnerRole() < ROLE_Authority)
     {
         Server_TakeDamage(DamageAmount, DamageCauser);
         return;
     }
 
+    ApplyDamage(DamageAmount, HitCount, DamageCauser);
+}
+
+void UHealthComponent::ApplyDamage(float DamageAmount, int32 HitCount, AActor* DamageCauser)
+{
     if (CurrentHealthState == EHealthState::Dead) return;
 
     float OldHealth = CurrentHealth;
@@ -172,19 +226,50 @@ void UHealthComponent::TakeDamage(float DamageAmount, AActor* DamageCauser)
 
     if (CurrentHealth != OldHealth)
     {
+        FGameplayTelemetry::Record(ETelemetryEvent::Damage, GetOwner(), DamageCauser, OldHealth - CurrentHealth, HitCount);
         OnHealthChanged.Broadcast(CurrentHealth);
         UpdateHealthState();
 
         if (GEngine)
         {
             GEngine->AddOnScreenDebugMessage(-7, 2.0f, FColor::Red, 
-                FString::Printf(TEXT("Damage: %.1f, Health: %.1f"), DamageAmount, CurrentHealth));
+                FString::Printf(TEXT("Damage: %.1f (%d hits), Health: %.1f"), DamageAmount, HitCount, CurrentHealth));
         }
     }
 }
 
+void UHealthComponent::WriteSaveData(FArchive& Ar) const
+{
+    float Health = CurrentHealth;
+    Ar << Health;
+}
+
+bool UHealthComponent::ReadSaveData(FArchive& Ar, uint16 Version)
+{
+    if (GetOwnerRole() < ROLE_Authority || Version > SaveDataVersion) return false;
+
+    float Health = 0.0f;
+    Ar << Health;
+    if (Ar.IsError() || !FMath::IsFinite(Health)) return false;
+
+    // Hits queued before the load belong to the state being replaced
+    PendingDamage = 0.0f;
+    PendingHitCount = 0;
+    PendingDamageCauser = nullptr;
+
+    // Downed and dead are not persisted, a returning player comes back with at least 1 HP
+    CurrentHealth = FMath::Clamp(Health, 1.0f, MaxHealth);
+    bIsDowned = false;
+    UpdateHealthState();
+    OnHealthChanged.Broadcast(CurrentHealth);
+    return true;
+}
+
 void UHealthComponent::Heal(float HealAmount)
 {
+    // Hits queued earlier in the frame land first, on clients their RPC goes out first
+    FlushPendingDamage();
+
     if (GetOwnerRole() < ROLE_Authority)
     {
         Server_Heal(HealAmount);
@@ -198,6 +283,7 @@ void UHealthComponent::Heal(float HealAmount)
 
     if (CurrentHealth != OldHealth)
     {
+        FGameplayTelemetry::Record(ETelemetryEvent::Heal, GetOwner(), nullptr, CurrentHealth - OldHealth);
         OnHealthChanged.Broadcast(CurrentHealth);
         UpdateHealthState();
 
@@ -237,6 +323,7 @@ void UHealthComponent::CompleteRevival()
 
     if (bIsDowned && CurrentReviver.IsValid())
     {
+        FGameplayTelemetry::Record(ETelemetryEvent::Revived, GetOwner(), CurrentReviver.Get());
         Heal(RevivalHealthAmount);
         bIsDowned = false;
         
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "../../Core/Net/QuantizedVital.h"
 #include "HealthComponent.generated.h"
 
 UENUM(BlueprintType)
@@ -32,18 +33,38 @@ public:
 	// Sets default values for this component's properties
 	UHealthComponent();
 
+#if WITH_DEV_AUTOMATION_TESTS
+    friend struct FGameplayTestAccess;
+#endif
+
 	protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
     // Health Properties
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health")
     float MaxHealth = 100.0f;
 
-    UPROPERTY(ReplicatedUsing = OnRep_Health, BlueprintReadOnly, Category = "Health")
+    // Exact on the server, decoded from ReplicatedHealth on clients
+    UPROPERTY(BlueprintReadOnly, Category = "Health")
     float CurrentHealth;
 
+    UPROPERTY(ReplicatedUsing = OnRep_Health)
+    FQuantizedVital ReplicatedHealth;
+
+    // Precision of the replicated health over MaxHealth, and how many of those steps it must move before it is sent
+    UPROPERTY(EditDefaultsOnly, Category = "Health|Replication", meta = (ClampMin = "1", ClampMax = "1023"))
+    int32 ReplicationSteps = FQuantizedVital::MaxSteps;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Health|Replication", meta = (ClampMin = "1"))
+    int32 ReplicationThreshold = 1;
+
+    // Seconds after a change held back by the threshold before the exact step is sent anyway
+    UPROPERTY(EditDefaultsOnly, Category = "Health|Replication", meta = (ClampMin = "0.01"))
+    float ReplicationSettleDelay = 0.5f;
+
     UPROPERTY(ReplicatedUsing = OnRep_HealthState, BlueprintReadOnly, Category = "Health")
     EHealthState CurrentHealthState;
 
@@ -80,13 +101,22 @@ public:
 
     // Internal functions
     void UpdateHealthState();
+    void SettleReplicatedHealth();
     void ApplyHealthStateEffects();
 
 public:
     // Public functions
+    // Hits are queued and applied together at the end of the frame, see FlushPendingDamage.
+    // Clients send the frame's total to the server in one RPC.
     UFUNCTION(BlueprintCallable, Category = "Health")
     void TakeDamage(float DamageAmount, AActor* DamageCauser = nullptr);
 
+    // Applies this frame's queued hits now instead of at the end of the frame
+    void FlushPendingDamage();
+
+    // Damage queued this frame and not applied yet
+    float GetPendingDamage() const { return PendingDamage; }
+
     UFUNCTION(BlueprintCallable, Category = "Health")
     void Heal(float HealAmount);
 
@@ -112,6 +142,11 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Revival")
     void CancelRevival();
 
+    // Persistence, see UPlayerSaveSubsystem. Server only.
+    static constexpr uint16 SaveDataVersion = 1;
+    void WriteSaveData(FArchive& Ar) const;
+    bool ReadSaveData(FArchive& Ar, uint16 Version);
+
     // Delegates
     UPROPERTY(BlueprintAssignable, Category = "Health")
     FOnHealthChanged OnHealthChanged;
@@ -127,8 +162,16 @@ public:
 
 private:
     FTimerHandle RevivalTimerHandle;
+    FTimerHandle ReplicationSettleTimerHandle;
     TWeakObjectPtr<APawn> CurrentReviver;
 
+    // This frame's hits, summed. The causer is the last one to hit.
+    float PendingDamage = 0.0f;
+    int32 PendingHitCount = 0;
+    TWeakObjectPtr<AActor> PendingDamageCauser;
+
+    void ApplyDamage(float DamageAmount, int32 HitCount, AActor* DamageCauser);
+
     UFUNCTION(Server, Reliable)
     void Server_TakeDamage(float DamageAmount, AActor* DamageCauser);
 
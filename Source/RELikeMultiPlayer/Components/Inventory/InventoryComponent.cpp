@@ -1,15 +1,108 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "InventoryComponent.h"
+#include "InventoryPage.h"
+#include "../../Core/Subsystems/StatusEffectSubsystem.h"
+#include "../../Core/Telemetry/GameplayTelemetry.h"
 #include "../../Items/Base/ItemPickup.h"
+#include "../../Items/Registry/ItemRegistrySubsystem.h"
 #include "../Health/HealthComponent.h"
+#include "../Stamina/StaminaComponent.h"
+#include "Algo/AnyOf.h"
 #include "Engine/DataTable.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/Core/Misc/NetConditionGroupManager.h"
+#include "Stats/Stats.h"
+
+FInventoryOp FInventoryOp::MakeAdd(FItemHandle InItemHandle, int32 InQuantity)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Add;
+    Op.ItemHandle = InItemHandle;
+    Op.Quantity = InQuantity;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeRemove(int32 InSlot, int32 InQuantity)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Remove;
+    Op.SlotA = InSlot;
+    Op.Quantity = InQuantity;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeDrop(int32 InSlot, int32 InQuantity)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Drop;
+    Op.SlotA = InSlot;
+    Op.Quantity = InQuantity;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeUse(int32 InSlot)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Use;
+    Op.SlotA = InSlot;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeSwap(int32 InFromSlot, int32 InToSlot)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Swap;
+    Op.SlotA = InFromSlot;
+    Op.SlotB = InToSlot;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeMove(int32 InFromSlot, int32 InToSlot, int32 InQuantity)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Move;
+    Op.SlotA = InFromSlot;
+    Op.SlotB = InToSlot;
+    Op.Quantity = InQuantity;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeCombine(int32 InSlotA, int32 InSlotB)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Combine;
+    Op.SlotA = InSlotA;
+    Op.SlotB = InSlotB;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeRotate(int32 InSlot)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Rotate;
+    Op.SlotA = InSlot;
+    return Op;
+}
+
+FInventoryOp FInventoryOp::MakeSort(EInventorySortMode InSortMode)
+{
+    FInventoryOp Op;
+    Op.Type = EInventoryOpType::Sort;
+    Op.SlotA = (int32)InSortMode;
+    return Op;
+}
 
 UInventoryComponent::UInventoryComponent()
+    : Inventory(this)
+    , Attributes(this)
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Ticks only while change notifications are waiting to be delivered
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_LastDemotable;
     SetIsReplicatedByDefault(true);
     
     UE_LOG(LogTemp, Log, TEXT("InventoryComponent Constructor: Component created with default replication"));
@@ -27,20 +120,87 @@ void UInventoryComponent::BeginPlay()
         GetOwnerRole() == ROLE_SimulatedProxy ? TEXT("SimulatedProxy") : TEXT("None"),
         GetIsReplicated() ? TEXT("Yes") : TEXT("No"));
 
+    // Resolve the item registry once; lookups are then plain array indexing
+    ItemRegistry = UItemRegistrySubsystem::Get(this);
+    if (ItemRegistry && !ItemRegistry->IsBuilt())
+    {
+        ItemRegistry->BuildFromDataTable(ItemDataTable);
+    }
+
+    if (AActor* Owner = GetOwner())
+    {
+        CachedHealth = Owner->FindComponentByClass<UHealthComponent>();
+        CachedStamina = Owner->FindComponentByClass<UStaminaComponent>();
+    }
+
+    if (bUseGridLayout && (bUsePagedReplication || InventoryColumns > FInventoryGrid::MaxColumns))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InventoryComponent: Grid layout needs unpaged replication and at most %d columns, using slots"),
+            FInventoryGrid::MaxColumns);
+        bUseGridLayout = false;
+    }
+    Model.Reset(InventoryColumns, InventoryRows, bUseGridLayout,
+        ItemRegistry ? ItemRegistry->GetModelItems() : TConstArrayView<FInventoryModelItem>());
+    Model.OnSlotWritten = [this](int32 SlotIndex) { HandleModelSlotWritten(SlotIndex); };
+
+    // Slots can replicate before BeginPlay, so bring the model up to date with what the list already holds
+    {
+        TGuardValue<bool> MirrorOnly(bMirrorModelWritesOnly, true);
+        for (const FInventorySlot& Slot : Inventory.Slots)
+        {
+            if (Slot.ItemHandle.IsValid())
+            {
+                Model.WriteSlot(Slot.SlotIndex, Slot.ItemHandle.Index, Slot.Quantity, Slot.bRotated);
+            }
+        }
+    }
+
     // Initialize inventory on server
     if (GetOwnerRole() == ROLE_Authority)
     {
-        Inventory.SetNum(GetTotalSlots());
+        // Slots are created once, in index order, so the client array mirrors the server layout
+        Inventory.Slots.SetNum(GetTotalSlots());
         for (int32 i = 0; i < GetTotalSlots(); i++)
         {
-            Inventory[i].SlotIndex = i;
+            Inventory.Slots[i].SlotIndex = i;
+            Inventory.MarkItemDirty(Inventory.Slots[i]);
+        }
+
+        if (bUsePagedReplication)
+        {
+            InitializePages();
+        }
+
+        // Registered as COND_Dynamic, set once before the first replication.
+        // Paged containers have no owning player, so their few attribute entries go to everyone.
+        const bool bOwnerOnly = !bUsePagedReplication && bReplicateSlotsToOwnerOnly;
+        if (bOwnerOnly)
+        {
+            DOREPDYNAMICCONDITION_INITCONDITION_FAST(UInventoryComponent, Inventory, COND_OwnerOnly);
+            DOREPDYNAMICCONDITION_INITCONDITION_FAST(UInventoryComponent, Attributes, COND_OwnerOnly);
+        }
+        else
+        {
+            DOREPDYNAMICCONDITION_INITCONDITION_FAST(UInventoryComponent, Inventory, COND_None);
+            DOREPDYNAMICCONDITION_INITCONDITION_FAST(UInventoryComponent, Attributes, COND_None);
         }
+        Summary.TotalSlots = GetTotalSlots();
+        UpdateSummary();
         UE_LOG(LogTemp, Log, TEXT("InventoryComponent: Initialized on Authority - Slots: %d"), GetTotalSlots());
     }
+    else if (bUsePagedReplication)
+    {
+        // The list itself is not replicated when paged; open pages fill it in
+        Inventory.Slots.SetNum(GetTotalSlots());
+        for (int32 i = 0; i < GetTotalSlots(); i++)
+        {
+            Inventory.Slots[i].SlotIndex = i;
+        }
+    }
     else
     {
         UE_LOG(LogTemp, Log, TEXT("InventoryComponent: Client initialization - waiting for replication"));
-        UE_LOG(LogTemp, Log, TEXT("InventoryComponent: Current inventory size: %d"), Inventory.Num());
+        UE_LOG(LogTemp, Log, TEXT("InventoryComponent: Current inventory size: %d"), Inventory.Slots.Num());
     }
     
     UE_LOG(LogTemp, Warning, TEXT("=== INVENTORY COMPONENT BEGINPLAY END ==="));
@@ -50,371 +210,1697 @@ void UInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     UE_LOG(LogTemp, Log, TEXT("InventoryComponent EndPlay - Owner: %s, Reason: %d"), 
         GetOwner() ? *GetOwner()->GetName() : TEXT("NULL"), (int32)EndPlayReason);
+
+    // Take every viewer out of the page groups before the pages go away
+    for (const TPair<TWeakObjectPtr<APlayerController>, FPageViewer>& Viewer : ViewerPages)
+    {
+        ClosePageViewer(Viewer.Key.Get(), Viewer.Value);
+    }
+    ViewerPages.Reset();
+
+    for (UInventoryPage* Page : Pages)
+    {
+        RemoveReplicatedSubObject(Page);
+        FNetConditionGroupManager::UnregisterSubObjectFromAllGroups(Page);
+    }
+    Pages.Reset();
     
     Super::EndPlay(EndPlayReason);
 }
 
+void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    FlushChangeNotifications();
+}
+
 void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(UInventoryComponent, Inventory);
+    // Owner-only or public is chosen per component in BeginPlay
+    DOREPLIFETIME_CONDITION(UInventoryComponent, Inventory, COND_Dynamic);
+    DOREPLIFETIME_CONDITION(UInventoryComponent, Attributes, COND_Dynamic);
+    DOREPLIFETIME_CONDITION(UInventoryComponent, LastProcessedPredictionKey, COND_OwnerOnly);
+    DOREPLIFETIME(UInventoryComponent, Summary);
     
     UE_LOG(LogTemp, VeryVerbose, TEXT("InventoryComponent: Replication properties registered"));
 }
 
-void UInventoryComponent::OnRep_Inventory()
+void UInventoryComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
 {
-    UE_LOG(LogTemp, Log, TEXT("InventoryComponent OnRep_Inventory: %d slots replicated"), Inventory.Num());
-    
-    // Update UI for all slots
-    for (int32 i = 0; i < Inventory.Num(); i++)
+    Super::PreReplication(ChangedPropertyTracker);
+
+    // Paged inventories send slots through their pages instead
+    DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UInventoryComponent, Inventory, !bUsePagedReplication);
+}
+
+void UInventoryComponent::InitializePages()
+{
+    SlotsPerPage = FMath::Max(1, SlotsPerPage);
+    const int32 NumPages = FMath::DivideAndRoundUp(GetTotalSlots(), SlotsPerPage);
+    for (int32 PageIndex = 0; PageIndex < NumPages; PageIndex++)
     {
-        OnInventoryUpdated.Broadcast(i, Inventory[i]);
+        const int32 FirstSlot = PageIndex * SlotsPerPage;
+        UInventoryPage* Page = NewObject<UInventoryPage>(this);
+        Page->InitializePage(PageIndex, FirstSlot, FMath::Min(SlotsPerPage, GetTotalSlots() - FirstSlot));
+
+        // Each page only goes to the connections whose controller is in its group
+        FNetConditionGroupManager::RegisterSubObjectInGroup(Page, Page->GetNetGroup());
+        AddReplicatedSubObject(Page, COND_NetGroup);
+        Pages.Add(Page);
+    }
+
+    if (!GetOwner()->IsUsingRegisteredSubObjectList())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InventoryComponent: %s uses paged replication but its owner does not replicate using the registered subobject list"),
+            *GetOwner()->GetName());
     }
 }
 
-bool UInventoryComponent::IsValidSlotIndex(int32 SlotIndex) const
+bool UInventoryComponent::AddPageViewer(APlayerController* Viewer, int32 PageIndex)
+{
+    if (!Viewer || !bUsePagedReplication || !Pages.IsValidIndex(PageIndex)) return false;
+
+    RemoveStalePageViewers();
+
+    FPageViewer* PageViewer = ViewerPages.Find(Viewer);
+    if (!PageViewer)
+    {
+        PageViewer = &ViewerPages.Add(Viewer);
+        Viewer->OnDestroyed.AddUniqueDynamic(this, &UInventoryComponent::OnPageViewerDestroyed);
+    }
+
+    // Pages stay open for the pawn that opened them, a respawned player asks again
+    APawn* Pawn = Viewer->GetPawn();
+    if (PageViewer->Pawn.Get() != Pawn)
+    {
+        if (APawn* OldPawn = PageViewer->Pawn.Get())
+        {
+            OldPawn->OnDestroyed.RemoveDynamic(this, &UInventoryComponent::OnPageViewerDestroyed);
+        }
+        PageViewer->Pawn = Pawn;
+        if (Pawn)
+        {
+            Pawn->OnDestroyed.AddUniqueDynamic(this, &UInventoryComponent::OnPageViewerDestroyed);
+        }
+    }
+
+    TBitArray<>& OpenPages = PageViewer->OpenPages;
+    if (OpenPages.Num() < Pages.Num())
+    {
+        OpenPages.Add(false, Pages.Num() - OpenPages.Num());
+    }
+
+    if (!OpenPages[PageIndex])
+    {
+        OpenPages[PageIndex] = true;
+        Viewer->IncludeInNetConditionGroup(Pages[PageIndex]->GetNetGroup());
+    }
+    return true;
+}
+
+void UInventoryComponent::RemovePageViewer(APlayerController* Viewer, int32 PageIndex)
 {
-    return SlotIndex >= 0 && SlotIndex < GetTotalSlots();
+    FPageViewer* PageViewer = ViewerPages.Find(Viewer);
+    if (!PageViewer) return;
+
+    if (PageIndex == INDEX_NONE)
+    {
+        ClosePageViewer(Viewer, *PageViewer);
+        ViewerPages.Remove(Viewer);
+    }
+    else if (PageViewer->OpenPages.IsValidIndex(PageIndex) && PageViewer->OpenPages[PageIndex])
+    {
+        PageViewer->OpenPages[PageIndex] = false;
+        Viewer->RemoveFromNetConditionGroup(Pages[PageIndex]->GetNetGroup());
+    }
 }
 
-FItemData* UInventoryComponent::GetItemData(const FString& ItemID) const
+bool UInventoryComponent::CanViewPages(const APlayerController* Viewer) const
 {
-    if (!ItemDataTable) return nullptr;
+    const AActor* Owner = GetOwner();
+    if (!Viewer || !Owner) return false;
 
-    static const FString ContextString(TEXT("Item Lookup"));
-    return ItemDataTable->FindRow<FItemData>(FName(*ItemID), ContextString);
+    // Containers owned by the player (their own stash, a pawn's bag) open from anywhere
+    if (Owner->IsOwnedBy(Viewer)) return true;
+
+    const APawn* Pawn = Viewer->GetPawn();
+    return Pawn && FVector::DistSquared(Pawn->GetActorLocation(), Owner->GetActorLocation()) <= FMath::Square(MaxViewerDistance);
 }
 
-int32 UInventoryComponent::FindFirstEmptySlot() const
+void UInventoryComponent::ClosePageViewer(APlayerController* Viewer, const FPageViewer& PageViewer)
 {
-    for (int32 i = 0; i < Inventory.Num(); i++)
+    if (Viewer)
     {
-        if (Inventory[i].ItemID.IsEmpty())
+        for (TConstSetBitIterator<> It(PageViewer.OpenPages); It; ++It)
         {
-            return i;
+            Viewer->RemoveFromNetConditionGroup(Pages[It.GetIndex()]->GetNetGroup());
         }
+        Viewer->OnDestroyed.RemoveDynamic(this, &UInventoryComponent::OnPageViewerDestroyed);
+    }
+    if (APawn* Pawn = PageViewer.Pawn.Get())
+    {
+        Pawn->OnDestroyed.RemoveDynamic(this, &UInventoryComponent::OnPageViewerDestroyed);
     }
-    return -1;
 }
 
-int32 UInventoryComponent::FindItemSlot(const FString& ItemID) const
+void UInventoryComponent::OnPageViewerDestroyed(AActor* DestroyedActor)
 {
-    for (int32 i = 0; i < Inventory.Num(); i++)
+    for (auto It = ViewerPages.CreateIterator(); It; ++It)
     {
-        if (Inventory[i].ItemID == ItemID)
+        if (It->Key.Get() == DestroyedActor || It->Value.Pawn.Get() == DestroyedActor)
         {
-            return i;
+            ClosePageViewer(It->Key.Get(), It->Value);
+            It.RemoveCurrent();
         }
     }
-    return -1;
 }
 
-int32 UInventoryComponent::FindPartialStackSlot(const FString& ItemID) const
+void UInventoryComponent::RemoveStalePageViewers()
 {
-    FItemData* ItemData = GetItemData(ItemID);
-    if (!ItemData || !ItemData->bStackable) return -1;
-
-    for (int32 i = 0; i < Inventory.Num(); i++)
+    // Catches viewers that went away without being destroyed first, e.g. on travel
+    for (auto It = ViewerPages.CreateIterator(); It; ++It)
     {
-        if (Inventory[i].ItemID == ItemID && Inventory[i].Quantity < ItemData->MaxStackSize)
+        if (!It->Key.IsValid() || It->Value.Pawn.IsStale())
         {
-            return i;
+            ClosePageViewer(It->Key.Get(), It->Value);
+            It.RemoveCurrent();
         }
     }
-    return -1;
 }
 
-bool UInventoryComponent::AddItem(const FString& ItemID, int32 Quantity)
+APlayerController* UInventoryComponent::GetOwningPlayerController() const
 {
-    if (GetOwnerRole() < ROLE_Authority)
-    {
-        Server_AddItem(ItemID, Quantity);
-        return true; // Assume success on client
-    }
-
-    FItemData* ItemData = GetItemData(ItemID);
-    if (!ItemData || Quantity <= 0) return false;
+    const APawn* Pawn = Cast<APawn>(GetOwner());
+    return Pawn ? Pawn->GetController<APlayerController>() : nullptr;
+}
 
-    int32 RemainingQuantity = Quantity;
+DECLARE_STATS_GROUP(TEXT("Inventory"), STATGROUP_Inventory, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Slots Sent"), STAT_InventorySlotsSent, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Slot Bytes Sent"), STAT_InventorySlotBytesSent, STATGROUP_Inventory);
 
-    // If stackable, try to add to existing stacks first
-    if (ItemData->bStackable)
+namespace
+{
+    // Size of a value written with FArchive::SerializeIntPacked (7 bits per byte)
+    int32 GetPackedIntBytes(uint32 Value)
     {
-        while (RemainingQuantity > 0)
+        int32 NumBytes = 1;
+        while (Value >= 0x80)
         {
-            int32 PartialSlot = FindPartialStackSlot(ItemID);
-            if (PartialSlot == -1) break;
+            Value >>= 7;
+            NumBytes++;
+        }
+        return NumBytes;
+    }
+}
 
-            int32 SpaceInStack = ItemData->MaxStackSize - Inventory[PartialSlot].Quantity;
-            int32 QuantityToAdd = FMath::Min(RemainingQuantity, SpaceInStack);
+bool FInventorySlot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    // The slot index goes first, a single byte for the first 128 slots
+    uint32 PackedSlotIndex = uint32(FMath::Max(SlotIndex, 0));
 
-            Inventory[PartialSlot].Quantity += QuantityToAdd;
-            RemainingQuantity -= QuantityToAdd;
+    // Handle index + 1 so an empty slot is a single zero byte with no quantity, shifted up to make room for the rotation bit
+    uint32 PackedHandle = ItemHandle.IsValid() && Quantity > 0 ? (uint32(ItemHandle.Index + 1) << 1) | (bRotated ? 1 : 0) : 0;
+    uint32 PackedQuantity = PackedHandle != 0 ? uint32(Quantity) : 0;
 
-            OnInventoryUpdated.Broadcast(PartialSlot, Inventory[PartialSlot]);
-        }
+    Ar.SerializeIntPacked(PackedSlotIndex);
+    Ar.SerializeIntPacked(PackedHandle);
+    if (PackedHandle != 0)
+    {
+        Ar.SerializeIntPacked(PackedQuantity);
     }
 
-    // Add remaining items to empty slots
-    while (RemainingQuantity > 0)
+    if (Ar.IsLoading())
+    {
+        SlotIndex = int32(PackedSlotIndex);
+        ItemHandle = FItemHandle(int32(PackedHandle >> 1) - 1);
+        Quantity = int32(PackedQuantity);
+        bRotated = (PackedHandle & 1) != 0;
+    }
+    else
     {
-        int32 EmptySlot = FindFirstEmptySlot();
-        if (EmptySlot == -1) return false; // Inventory full
+        INC_DWORD_STAT(STAT_InventorySlotsSent);
+        INC_DWORD_STAT_BY(STAT_InventorySlotBytesSent, GetPackedIntBytes(PackedSlotIndex) + GetPackedIntBytes(PackedHandle)
+            + (PackedHandle != 0 ? GetPackedIntBytes(PackedQuantity) : 0));
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
 
-        int32 QuantityToAdd = ItemData->bStackable ? 
-            FMath::Min(RemainingQuantity, ItemData->MaxStackSize) : 1;
+void FItemAttributeEntry::PreReplicatedRemove(const FItemAttributeList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->QueueSlotBroadcast(SlotIndex);
+    }
+}
 
-        Inventory[EmptySlot].ItemID = ItemID;
-        Inventory[EmptySlot].Quantity = QuantityToAdd;
-        RemainingQuantity -= QuantityToAdd;
+void FItemAttributeEntry::PostReplicatedAdd(const FItemAttributeList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->QueueSlotBroadcast(SlotIndex);
+    }
+}
 
-        OnInventoryUpdated.Broadcast(EmptySlot, Inventory[EmptySlot]);
+void FItemAttributeEntry::PostReplicatedChange(const FItemAttributeList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->QueueSlotBroadcast(SlotIndex);
     }
+}
 
-    Multicast_OnItemPickedUp(ItemID);
-    return true;
+void FInventorySlot::PreReplicatedRemove(const FInventoryList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->OnSlotReplicatedRemove(*this);
+    }
 }
 
-bool UInventoryComponent::RemoveItem(int32 SlotIndex, int32 Quantity)
+void FInventorySlot::PostReplicatedAdd(const FInventoryList& InArraySerializer)
 {
-    if (GetOwnerRole() < ROLE_Authority)
+    if (InArraySerializer.OwnerComponent)
     {
-        Server_RemoveItem(SlotIndex, Quantity);
-        return true;
+        InArraySerializer.OwnerComponent->RestoreReplicatedSlot(*this);
+        InArraySerializer.OwnerComponent->OnSlotReplicatedAdd(*this);
     }
+}
 
-    if (!IsValidSlotIndex(SlotIndex) || Inventory[SlotIndex].ItemID.IsEmpty()) return false;
+void FInventorySlot::PostReplicatedChange(const FInventoryList& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->RestoreReplicatedSlot(*this);
+        InArraySerializer.OwnerComponent->OnSlotReplicatedChange(*this);
+    }
+}
 
-    if (Inventory[SlotIndex].Quantity > Quantity)
+void UInventoryComponent::RestoreReplicatedSlot(FInventorySlot& Slot) const
+{
+    const FItemDefinition* ItemData = GetItemDefinition(Slot.ItemHandle);
+    if (!ItemData)
     {
-        Inventory[SlotIndex].Quantity -= Quantity;
+        Slot.ItemID.Reset();
     }
-    else
+    else if (Slot.ItemID != ItemData->ItemID)
     {
-        Inventory[SlotIndex].ItemID = "";
-        Inventory[SlotIndex].Quantity = 0;
+        Slot.ItemID = ItemData->ItemID;
     }
+}
 
-    OnInventoryUpdated.Broadcast(SlotIndex, Inventory[SlotIndex]);
-    return true;
+void UInventoryComponent::OnSlotReplicatedAdd(const FInventorySlot& Slot)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("InventoryComponent OnSlotReplicatedAdd: Slot %d"), Slot.SlotIndex);
+    ReceiveAuthoritativeSlot(Slot);
 }
 
-bool UInventoryComponent::DropItem(int32 SlotIndex, int32 Quantity)
+void UInventoryComponent::OnSlotReplicatedChange(const FInventorySlot& Slot)
 {
-    if (GetOwnerRole() < ROLE_Authority)
+    UE_LOG(LogTemp, Verbose, TEXT("InventoryComponent OnSlotReplicatedChange: Slot %d"), Slot.SlotIndex);
+    ReceiveAuthoritativeSlot(Slot);
+}
+
+void UInventoryComponent::OnSlotReplicatedRemove(const FInventorySlot& Slot)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("InventoryComponent OnSlotReplicatedRemove: Slot %d"), Slot.SlotIndex);
+
+    // The slot is going away, so listeners see it as emptied
+    FInventorySlot EmptySlot;
+    EmptySlot.SlotIndex = Slot.SlotIndex;
+    ReceiveAuthoritativeSlot(EmptySlot);
+}
+
+void UInventoryComponent::ReceiveAuthoritativeSlot(const FInventorySlot& Slot)
+{
+    if (!AuthoritativeSlots.IsValidIndex(Slot.SlotIndex))
     {
-        Server_DropItem(SlotIndex, Quantity);
-        return true;
+        AuthoritativeSlots.SetNum(Slot.SlotIndex + 1);
     }
+    AuthoritativeSlots[Slot.SlotIndex] = { Slot.SlotIndex, Slot.ItemHandle, Slot.Quantity, Slot.bRotated };
 
-    if (!IsValidSlotIndex(SlotIndex) || Inventory[SlotIndex].ItemID.IsEmpty()) return false;
+    // Paged slots arrive in their page, and the mirror copies them into the local list
+    {
+        TGuardValue<bool> MirrorOnly(bMirrorModelWritesOnly, true);
+        Model.WriteSlot(Slot.SlotIndex, Slot.ItemHandle.Index, Slot.Quantity, Slot.bRotated);
+    }
 
-    FString ItemID = Inventory[SlotIndex].ItemID;
-    int32 QuantityToDrop = FMath::Min(Quantity, Inventory[SlotIndex].Quantity);
+    // Slots of one update arrive in any order, so footprints may briefly overlap
+    Model.MarkGridDirty();
 
-    // Spawn pickup in world
-    FItemData* ItemData = GetItemData(ItemID);
-    if (ItemData && ItemData->PickupClass)
+    // With predictions in flight the slot is rebuilt from here in ReconcilePredictions
+    if (PendingPredictions.Num() > 0)
     {
-        FVector SpawnLocation = GetOwner()->GetActorLocation() + 
-            GetOwner()->GetActorForwardVector() * 100.0f;
-        
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-        
-        AItemPickup* DroppedItem = GetWorld()->SpawnActor<AItemPickup>(
-            ItemData->PickupClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
-        
-        if (DroppedItem)
-        {
-            DroppedItem->SetItemData(ItemID, QuantityToDrop);
-        }
+        bAuthoritativeSlotsChanged = true;
     }
+    QueueSlotBroadcast(Slot.SlotIndex);
+}
+
+void UInventoryComponent::OnRep_Inventory()
+{
+    ReconcilePredictions();
+}
+
+void UInventoryComponent::OnRep_LastProcessedPredictionKey()
+{
+    // Also arrives alone when the server rejected a batch and no slot changed
+    ReconcilePredictions();
+}
 
-    RemoveItem(SlotIndex, QuantityToDrop);
-    Multicast_OnItemDropped(ItemID, QuantityToDrop);
+bool UInventoryComponent::PredictOps(TConstArrayView<FInventoryOp> Ops)
+{
+    // Ops that fail locally would fail on the server too, so they are never sent
+    if (HasServerOnlyOps(Ops)) return false;
+
+    bPredicting = true;
+    const bool bSuccess = ExecuteOps(Ops);
+    bPredicting = false;
+    if (!bSuccess) return false;
+
+    FPendingInventoryPrediction& Prediction = PendingPredictions.AddDefaulted_GetRef();
+    Prediction.PredictionKey = ++LastPredictionKey;
+    Prediction.Ops.Append(Ops.GetData(), Ops.Num());
+
+    Server_ApplyInventoryOps(Prediction.Ops, Prediction.PredictionKey);
     return true;
 }
 
-bool UInventoryComponent::UseItem(int32 SlotIndex)
+bool UInventoryComponent::HasServerOnlyOps(TConstArrayView<FInventoryOp> Ops)
 {
-    if (GetOwnerRole() < ROLE_Authority)
+    return Algo::AnyOf(Ops, [](const FInventoryOp& Op) { return Op.Type == EInventoryOpType::Add; });
+}
+
+void UInventoryComponent::ReconcilePredictions()
+{
+    // Predictions the server has processed are part of the authoritative slots now
+    int32 NumProcessed = 0;
+    while (NumProcessed < PendingPredictions.Num() && PendingPredictions[NumProcessed].PredictionKey <= LastProcessedPredictionKey)
     {
-        Server_UseItem(SlotIndex);
-        return true;
+        NumProcessed++;
     }
+    if (NumProcessed == 0 && !bAuthoritativeSlotsChanged) return;
 
-    if (!IsValidSlotIndex(SlotIndex) || Inventory[SlotIndex].ItemID.IsEmpty()) return false;
+    PendingPredictions.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+    bAuthoritativeSlotsChanged = false;
 
-    FString ItemID = Inventory[SlotIndex].ItemID;
-    FItemData* ItemData = GetItemData(ItemID);
-    if (!ItemData) return false;
-
-    // Handle item use based on category
-    switch (ItemData->Category)
+    // Rewind every slot to the authoritative state, then replay what the server has not seen yet
+    const int32 NumSlots = FMath::Min(Inventory.Slots.Num(), AuthoritativeSlots.Num());
+    for (int32 i = 0; i < NumSlots; i++)
     {
-    case EItemCategory::Medical:
-        // Heal the player
-        if (ACharacter* Character = Cast<ACharacter>(GetOwner()))
+        const FSlotContents& Authoritative = AuthoritativeSlots[i];
+        const FInventorySlot& Slot = Inventory.Slots[i];
+        if (Slot.ItemHandle != Authoritative.ItemHandle || Slot.Quantity != Authoritative.Quantity || Slot.bRotated != Authoritative.bRotated)
         {
-            if (UHealthComponent* HealthComp = Character->FindComponentByClass<UHealthComponent>())
-            {
-                // Different healing amounts based on item
-                float HealAmount = 25.0f; // Default for bandages
-                if (ItemID == "medkit") HealAmount = 50.0f;
-                else if (ItemID == "painpills") HealAmount = 15.0f;
-                
-                HealthComp->Heal(HealAmount);
-                RemoveItem(SlotIndex, 1);
-                Multicast_OnItemUsed(ItemID, SlotIndex, 1);
-                return true;
-            }
+            WriteSlot(i, Authoritative.ItemHandle, Authoritative.Quantity, Authoritative.bRotated);
         }
-        break;
-    
-    case EItemCategory::Tools:
-        // Tools typically don't get consumed when used
-        Multicast_OnItemUsed(ItemID, SlotIndex, 0);
-        return true;
-    
-    default:
-        break;
     }
+    Model.MarkGridDirty();
 
-    return false;
+    bPredicting = true;
+    for (const FPendingInventoryPrediction& Prediction : PendingPredictions)
+    {
+        // A batch that no longer applies stays pending until the server rejects it as well
+        ExecuteOps(Prediction.Ops);
+    }
+    bPredicting = false;
 }
 
-bool UInventoryComponent::SwapItems(int32 FromSlot, int32 ToSlot)
+void UInventoryComponent::QueueSlotBroadcast(int32 SlotIndex)
 {
-    if (GetOwnerRole() < ROLE_Authority)
+    // Nothing to deliver to, e.g. on a dedicated server
+    if (!OnInventoryChanged.IsBound() && !OnInventoryUpdated.IsBound()) return;
+
+    if (PendingChangeMask.Num() <= SlotIndex)
     {
-        Server_SwapItems(FromSlot, ToSlot);
-        return true;
+        PendingChangeMask.Add(false, SlotIndex + 1 - PendingChangeMask.Num());
     }
+    if (PendingChangeMask[SlotIndex]) return;
 
-    if (!IsValidSlotIndex(FromSlot) || !IsValidSlotIndex(ToSlot)) return false;
+    PendingChangeMask[SlotIndex] = true;
+    PendingChangedSlots.Add(SlotIndex);
+    if (PendingChangedSlots.Num() == 1)
+    {
+        SetComponentTickEnabled(true);
+    }
+}
 
-    FInventorySlot TempSlot = Inventory[FromSlot];
-    Inventory[FromSlot] = Inventory[ToSlot];
-    Inventory[ToSlot] = TempSlot;
+void UInventoryComponent::FlushChangeNotifications()
+{
+    SetComponentTickEnabled(false);
+    if (PendingChangedSlots.Num() == 0) return;
 
-    // Maintain correct slot indices
-    Inventory[FromSlot].SlotIndex = FromSlot;
-    Inventory[ToSlot].SlotIndex = ToSlot;
+    // Listeners may change the inventory again, which starts a batch for the next frame
+    TArray<int32> ChangedSlots = MoveTemp(PendingChangedSlots);
+    PendingChangedSlots.Reset();
+    for (int32 SlotIndex : ChangedSlots)
+    {
+        PendingChangeMask[SlotIndex] = false;
+    }
+    ChangedSlots.Sort();
 
-    OnInventoryUpdated.Broadcast(FromSlot, Inventory[FromSlot]);
-    OnInventoryUpdated.Broadcast(ToSlot, Inventory[ToSlot]);
+    OnInventoryChanged.Broadcast(ChangedSlots);
 
-    return true;
+    if (OnInventoryUpdated.IsBound())
+    {
+        for (int32 SlotIndex : ChangedSlots)
+        {
+            if (Inventory.Slots.IsValidIndex(SlotIndex))
+            {
+                OnInventoryUpdated.Broadcast(SlotIndex, Inventory.Slots[SlotIndex]);
+            }
+        }
+    }
 }
 
-bool UInventoryComponent::TransferItem(int32 SlotIndex, UInventoryComponent* TargetInventory, int32 Quantity)
+void UInventoryComponent::WriteSlot(int32 SlotIndex, FItemHandle ItemHandle, int32 Quantity, bool bRotated)
 {
-    if (GetOwnerRole() < ROLE_Authority)
-    {
-        Server_TransferItem(SlotIndex, TargetInventory, Quantity);
-        return true;
-    }
+    Model.WriteSlot(SlotIndex, ItemHandle.Index, Quantity, bRotated);
+}
 
-    if (!IsValidSlotIndex(SlotIndex) || !TargetInventory || Inventory[SlotIndex].ItemID.IsEmpty()) return false;
+void UInventoryComponent::HandleModelSlotWritten(int32 SlotIndex)
+{
+    if (!Inventory.Slots.IsValidIndex(SlotIndex)) return;
 
-    FString ItemID = Inventory[SlotIndex].ItemID;
-    int32 QuantityToTransfer = FMath::Min(Quantity, Inventory[SlotIndex].Quantity);
+    FInventorySlot& Slot = Inventory.Slots[SlotIndex];
+    const FInventoryModelSlot& Contents = Model.GetSlot(SlotIndex);
 
-    // Try to add item to target inventory
-    if (TargetInventory->AddItem(ItemID, QuantityToTransfer))
+    // Remember the slot as it was before the first write of the transaction
+    if (!bMirrorModelWritesOnly && bInTransaction && !TransactionDirtyMask[SlotIndex])
     {
-        // Remove from source inventory
-        RemoveItem(SlotIndex, QuantityToTransfer);
-        return true;
+        TransactionUndo.Add({ SlotIndex, Slot.ItemHandle, Slot.Quantity, Slot.bRotated });
     }
 
-    return false;
-}
+    SetSlotContents(Slot, FItemHandle(Contents.ItemIndex), Contents.Quantity, Contents.bRotated);
 
-// Additional helper functions
-FInventorySlot UInventoryComponent::GetSlot(int32 SlotIndex) const
-{
-    if (IsValidSlotIndex(SlotIndex))
+    // Pickup classes are only loaded for items that are actually held, so dropping them never hitches
+    if (!Contents.IsEmpty() && ItemRegistry)
     {
-        return Inventory[SlotIndex];
+        ItemRegistry->PreloadPickupClass(Slot.ItemHandle);
     }
-    return FInventorySlot();
-}
 
-bool UInventoryComponent::HasItem(const FString& ItemID, int32 RequiredQuantity) const
-{
-    return GetItemCount(ItemID) >= RequiredQuantity;
+    if (!bMirrorModelWritesOnly)
+    {
+        MarkSlotDirty(SlotIndex);
+    }
 }
 
-int32 UInventoryComponent::GetItemCount(const FString& ItemID) const
+void UInventoryComponent::SetSlotContents(FInventorySlot& Slot, FItemHandle ItemHandle, int32 Quantity, bool bRotated) const
 {
-    int32 TotalCount = 0;
-    for (const FInventorySlot& Slot : Inventory)
+    const FItemDefinition* ItemData = Quantity > 0 ? GetItemDefinition(ItemHandle) : nullptr;
+    if (ItemData)
     {
-        if (Slot.ItemID == ItemID)
+        // Only touch the string when the item actually changes
+        if (Slot.ItemHandle != ItemHandle)
         {
-            TotalCount += Slot.Quantity;
+            Slot.ItemID = ItemData->ItemID;
+            Slot.ItemHandle = ItemHandle;
         }
+        Slot.Quantity = Quantity;
+        Slot.bRotated = bRotated;
+    }
+    else
+    {
+        Slot.ItemID.Reset();
+        Slot.ItemHandle = FItemHandle();
+        Slot.Quantity = 0;
+        Slot.bRotated = false;
     }
-    return TotalCount;
 }
 
-TArray<FInventorySlot> UInventoryComponent::GetAllItems() const
+void UInventoryComponent::MarkSlotDirty(int32 SlotIndex)
 {
-    TArray<FInventorySlot> NonEmptySlots;
-    for (const FInventorySlot& Slot : Inventory)
+    if (bInTransaction)
     {
-        if (!Slot.ItemID.IsEmpty())
+        // Published once on commit, however many times the slot is written
+        if (!TransactionDirtyMask[SlotIndex])
         {
-            NonEmptySlots.Add(Slot);
+            TransactionDirtyMask[SlotIndex] = true;
+            TransactionDirtySlots.Add(SlotIndex);
         }
+        return;
     }
-    return NonEmptySlots;
+
+    PublishSlot(SlotIndex);
 }
 
-void UInventoryComponent::ClearInventory()
+void UInventoryComponent::PublishSlot(int32 SlotIndex)
 {
-    if (GetOwnerRole() < ROLE_Authority) return;
-
-    for (int32 i = 0; i < Inventory.Num(); i++)
+    FInventorySlot& Slot = Inventory.Slots[SlotIndex];
+    if (GetOwnerRole() == ROLE_Authority)
     {
-        Inventory[i].ItemID = "";
-        Inventory[i].Quantity = 0;
-        OnInventoryUpdated.Broadcast(i, Inventory[i]);
+        if (bUsePagedReplication)
+        {
+            Pages[SlotIndex / SlotsPerPage]->MirrorSlot(Slot);
+        }
+        else
+        {
+            Inventory.MarkItemDirty(Slot);
+        }
     }
-}
 
-// Server RPC Implementations
-void UInventoryComponent::Server_AddItem_Implementation(const FString& ItemID, int32 Quantity)
-{
-    AddItem(ItemID, Quantity);
+    QueueSlotBroadcast(SlotIndex);
 }
 
-void UInventoryComponent::Server_RemoveItem_Implementation(int32 SlotIndex, int32 Quantity)
+void UInventoryComponent::BeginTransaction()
 {
-    RemoveItem(SlotIndex, Quantity);
-}
+    check(!bInTransaction);
+    bInTransaction = true;
 
-void UInventoryComponent::Server_DropItem_Implementation(int32 SlotIndex, int32 Quantity)
-{
-    DropItem(SlotIndex, Quantity);
+    if (TransactionDirtyMask.Num() != Inventory.Slots.Num())
+    {
+        TransactionDirtyMask.Init(false, Inventory.Slots.Num());
+    }
 }
 
-void UInventoryComponent::Server_UseItem_Implementation(int32 SlotIndex)
+void UInventoryComponent::CommitTransaction()
 {
-    UseItem(SlotIndex);
-}
+    check(bInTransaction);
+    bInTransaction = false;
 
-void UInventoryComponent::Server_SwapItems_Implementation(int32 FromSlot, int32 ToSlot)
-{
-    SwapItems(FromSlot, ToSlot);
+    for (int32 SlotIndex : TransactionDirtySlots)
+    {
+        TransactionDirtyMask[SlotIndex] = false;
+        PublishSlot(SlotIndex);
+    }
+
+    if (TransactionDirtySlots.Num() > 0 && GetOwnerRole() == ROLE_Authority)
+    {
+        Summary.Version++;
+        UpdateSummary();
+    }
+    TransactionDirtySlots.Reset();
+    TransactionUndo.Reset();
+    TransactionAttributeUndo.Reset();
+
+    // Actions may start a new transaction (e.g. a pickup spawned by a drop), so take them first
+    TArray<TFunction<void()>> Actions = MoveTemp(TransactionCommitActions);
+    TransactionCommitActions.Reset();
+    for (TFunction<void()>& Action : Actions)
+    {
+        Action();
+    }
+}
+
+void UInventoryComponent::UpdateSummary()
+{
+    Summary.OccupiedSlots = GetTotalSlots() - Model.GetNumFreeSlots();
+
+    // Key items are few, so checking their totals beats scanning the slots
+    Summary.bHasKeyItem = false;
+    if (ItemRegistry)
+    {
+        for (FItemHandle KeyItem : ItemRegistry->GetKeyItems())
+        {
+            if (Model.GetTotalQuantity(KeyItem.Index) > 0)
+            {
+                Summary.bHasKeyItem = true;
+                break;
+            }
+        }
+    }
+}
+
+void UInventoryComponent::RollbackTransaction()
+{
+    check(bInTransaction);
+    bInTransaction = false;
+
+    // Nothing was published, so restoring the model and its mirror is enough
+    {
+        TGuardValue<bool> MirrorOnly(bMirrorModelWritesOnly, true);
+        for (int32 i = TransactionUndo.Num() - 1; i >= 0; i--)
+        {
+            const FSlotContents& Undo = TransactionUndo[i];
+            Model.WriteSlot(Undo.SlotIndex, Undo.ItemHandle.Index, Undo.Quantity, Undo.bRotated);
+        }
+    }
+    Model.MarkGridDirty();
+
+    // Entries keep their replication IDs, so restoring the copy and resending the array is enough
+    if (TransactionAttributeUndo.IsSet())
+    {
+        Attributes.Entries = MoveTemp(TransactionAttributeUndo.GetValue());
+        Attributes.MarkArrayDirty();
+        TransactionAttributeUndo.Reset();
+    }
+
+    for (int32 SlotIndex : TransactionDirtySlots)
+    {
+        TransactionDirtyMask[SlotIndex] = false;
+    }
+    TransactionDirtySlots.Reset();
+    TransactionUndo.Reset();
+    TransactionCommitActions.Reset();
+}
+
+void UInventoryComponent::SaveAttributeUndo()
+{
+    if (bInTransaction && !TransactionAttributeUndo.IsSet())
+    {
+        TransactionAttributeUndo.Emplace(Attributes.Entries);
+    }
+}
+
+void UInventoryComponent::ClearSlotAttributes(int32 SlotIndex)
+{
+    if (!CanModifyAttributes()) return;
+
+    for (int32 i = Attributes.Entries.Num() - 1; i >= 0; i--)
+    {
+        if (Attributes.Entries[i].SlotIndex != SlotIndex) continue;
+
+        SaveAttributeUndo();
+        Attributes.Entries.RemoveAtSwap(i);
+        Attributes.MarkArrayDirty();
+        QueueSlotBroadcast(SlotIndex);
+    }
+}
+
+void UInventoryComponent::SwapSlotAttributes(int32 SlotA, int32 SlotB)
+{
+    if (!CanModifyAttributes() || SlotA == SlotB) return;
+
+    for (FItemAttributeEntry& Entry : Attributes.Entries)
+    {
+        if (Entry.SlotIndex != SlotA && Entry.SlotIndex != SlotB) continue;
+
+        SaveAttributeUndo();
+        Entry.SlotIndex = Entry.SlotIndex == SlotA ? SlotB : SlotA;
+        Attributes.MarkItemDirty(Entry);
+    }
+}
+
+void UInventoryComponent::RemapSlotAttributes(const TMap<int32, int32>& NewSlotByOldSlot)
+{
+    if (!CanModifyAttributes()) return;
+
+    // Entries of slots missing from the map are dropped
+    SaveAttributeUndo();
+    for (int32 i = Attributes.Entries.Num() - 1; i >= 0; i--)
+    {
+        FItemAttributeEntry& Entry = Attributes.Entries[i];
+        const int32* NewSlot = NewSlotByOldSlot.Find(Entry.SlotIndex);
+        if (!NewSlot)
+        {
+            Attributes.Entries.RemoveAtSwap(i);
+            Attributes.MarkArrayDirty();
+        }
+        else if (*NewSlot != Entry.SlotIndex)
+        {
+            Entry.SlotIndex = *NewSlot;
+            Attributes.MarkItemDirty(Entry);
+        }
+    }
+}
+
+void UInventoryComponent::DeferUntilCommit(TFunction<void()>&& Action)
+{
+    if (bPredicting)
+    {
+        return;
+    }
+
+    if (bInTransaction)
+    {
+        TransactionCommitActions.Add(MoveTemp(Action));
+    }
+    else
+    {
+        Action();
+    }
+}
+
+bool UInventoryComponent::IsValidSlotIndex(int32 SlotIndex) const
+{
+    // Clients only know the slots that have replicated so far
+    return SlotIndex >= 0 && SlotIndex < Inventory.Slots.Num();
+}
+
+UItemRegistrySubsystem* UInventoryComponent::GetItemRegistry() const
+{
+    return ItemRegistry ? ItemRegistry.Get() : UItemRegistrySubsystem::Get(this);
+}
+
+FItemHandle UInventoryComponent::FindItemHandle(const FString& ItemID) const
+{
+    const UItemRegistrySubsystem* Registry = GetItemRegistry();
+    return Registry ? Registry->FindItem(ItemID) : FItemHandle();
+}
+
+const FItemDefinition* UInventoryComponent::GetItemDefinition(FItemHandle ItemHandle) const
+{
+    const UItemRegistrySubsystem* Registry = GetItemRegistry();
+    return Registry ? Registry->GetDefinition(ItemHandle) : nullptr;
+}
+
+EItemCategory UInventoryComponent::GetItemCategory(FItemHandle ItemHandle) const
+{
+    const FItemDefinition* ItemData = GetItemDefinition(ItemHandle);
+    return ItemData ? ItemData->Category : EItemCategory::None;
+}
+
+bool UInventoryComponent::AddItem(const FString& ItemID, int32 Quantity)
+{
+    if (GetOwnerRole() < ROLE_Authority) return false;
+
+    return ExecuteOp(FInventoryOp::MakeAdd(FindItemHandle(ItemID), Quantity));
+}
+
+bool UInventoryComponent::RemoveItem(int32 SlotIndex, int32 Quantity)
+{
+    const FInventoryOp Op = FInventoryOp::MakeRemove(SlotIndex, Quantity);
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(MakeArrayView(&Op, 1));
+    }
+
+    return ExecuteOp(Op);
+}
+
+bool UInventoryComponent::DropItem(int32 SlotIndex, int32 Quantity)
+{
+    const FInventoryOp Op = FInventoryOp::MakeDrop(SlotIndex, Quantity);
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(MakeArrayView(&Op, 1));
+    }
+
+    return ExecuteOp(Op);
+}
+
+bool UInventoryComponent::UseItem(int32 SlotIndex)
+{
+    const FInventoryOp Op = FInventoryOp::MakeUse(SlotIndex);
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(MakeArrayView(&Op, 1));
+    }
+
+    return ExecuteOp(Op);
+}
+
+bool UInventoryComponent::SwapItems(int32 FromSlot, int32 ToSlot)
+{
+    const FInventoryOp Op = FInventoryOp::MakeSwap(FromSlot, ToSlot);
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(MakeArrayView(&Op, 1));
+    }
+
+    return ExecuteOp(Op);
+}
+
+bool UInventoryComponent::CombineItems(int32 SlotA, int32 SlotB)
+{
+    const FInventoryOp Op = FInventoryOp::MakeCombine(SlotA, SlotB);
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(MakeArrayView(&Op, 1));
+    }
+
+    return ExecuteOp(Op);
+}
+
+bool UInventoryComponent::RotateItem(int32 SlotIndex)
+{
+    const FInventoryOp Op = FInventoryOp::MakeRotate(SlotIndex);
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(MakeArrayView(&Op, 1));
+    }
+
+    return ExecuteOp(Op);
+}
+
+bool UInventoryComponent::SortAndCompact(EInventorySortMode SortMode)
+{
+    const FInventoryOp Op = FInventoryOp::MakeSort(SortMode);
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(MakeArrayView(&Op, 1));
+    }
+
+    return ExecuteOp(Op);
+}
+
+bool UInventoryComponent::ApplyInventoryOps(const TArray<FInventoryOp>& Ops)
+{
+    if (Ops.Num() == 0) return false;
+
+    if (Ops.Num() > MaxOpsPerBatch)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InventoryComponent: Rejected batch of %d ops (max %d)"), Ops.Num(), MaxOpsPerBatch);
+        return false;
+    }
+
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        return PredictOps(Ops);
+    }
+
+    return ExecuteOps(Ops);
+}
+
+bool UInventoryComponent::ExecuteOps(TConstArrayView<FInventoryOp> Ops)
+{
+    // Ops issued while a transaction is open join it, and the outer caller decides commit or rollback
+    const bool bOwnsTransaction = !bInTransaction;
+    if (bOwnsTransaction)
+    {
+        BeginTransaction();
+    }
+
+    for (const FInventoryOp& Op : Ops)
+    {
+        if (!ApplyOp(Op))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("InventoryComponent: Op %d failed (SlotA %d, SlotB %d, Quantity %d)"),
+                (int32)Op.Type, Op.SlotA, Op.SlotB, Op.Quantity);
+            if (bOwnsTransaction)
+            {
+                RollbackTransaction();
+            }
+            return false;
+        }
+    }
+
+    if (bOwnsTransaction)
+    {
+        CommitTransaction();
+    }
+    return true;
+}
+
+bool UInventoryComponent::ApplyOp(const FInventoryOp& Op)
+{
+    switch (Op.Type)
+    {
+    case EInventoryOpType::Add:     return AddItemInternal(Op.ItemHandle, Op.Quantity);
+    case EInventoryOpType::Remove:  return RemoveItemInternal(Op.SlotA, Op.Quantity);
+    case EInventoryOpType::Drop:    return DropItemInternal(Op.SlotA, Op.Quantity);
+    case EInventoryOpType::Use:     return UseItemInternal(Op.SlotA);
+    case EInventoryOpType::Swap:    return SwapItemsInternal(Op.SlotA, Op.SlotB);
+    case EInventoryOpType::Move:    return MoveItemInternal(Op.SlotA, Op.SlotB, Op.Quantity);
+    case EInventoryOpType::Combine: return CombineItemsInternal(Op.SlotA, Op.SlotB);
+    case EInventoryOpType::Rotate:  return RotateItemInternal(Op.SlotA);
+    case EInventoryOpType::Sort:    return SortAndCompactInternal((EInventorySortMode)Op.SlotA);
+    default:                        return false;
+    }
+}
+
+bool UInventoryComponent::AddItemInternal(FItemHandle ItemHandle, int32 Quantity, int32* OutLastSlot)
+{
+    const FItemDefinition* ItemData = GetItemDefinition(ItemHandle);
+    if (!ItemData || !Model.Add(ItemHandle.Index, Quantity, OutLastSlot)) return false;
+
+    FString ItemID = ItemData->ItemID;
+    DeferUntilCommit([this, ItemID, ItemHandle, Quantity]()
+    {
+        FGameplayTelemetry::Record(ETelemetryEvent::ItemPickedUp, GetOwner(), nullptr, float(Quantity), ItemHandle.Index);
+        Multicast_OnItemPickedUp(ItemID);
+    });
+    return true;
+}
+
+bool UInventoryComponent::RemoveItemInternal(int32 SlotIndex, int32 Quantity)
+{
+    if (!IsValidSlotIndex(SlotIndex) || !Inventory.Slots[SlotIndex].ItemHandle.IsValid() || Quantity <= 0) return false;
+
+    if (Inventory.Slots[SlotIndex].Quantity <= Quantity)
+    {
+        ClearSlotAttributes(SlotIndex);
+    }
+    return Model.Remove(SlotIndex, Quantity);
+}
+
+bool UInventoryComponent::DropItemInternal(int32 SlotIndex, int32 Quantity)
+{
+    if (!IsValidSlotIndex(SlotIndex) || !Inventory.Slots[SlotIndex].ItemHandle.IsValid() || Quantity <= 0) return false;
+
+    FString ItemID = Inventory.Slots[SlotIndex].ItemID;
+    TSoftClassPtr<AItemPickup> PickupClass;
+    if (const FItemDefinition* ItemData = GetItemDefinition(Inventory.Slots[SlotIndex].ItemHandle))
+    {
+        PickupClass = ItemData->PickupClass;
+    }
+    int32 QuantityToDrop = FMath::Min(Quantity, Inventory.Slots[SlotIndex].Quantity);
+
+    RemoveItemInternal(SlotIndex, QuantityToDrop);
+
+    // Spawn pickup in world once the removal is committed
+    DeferUntilCommit([this, ItemID, PickupClass, QuantityToDrop]()
+    {
+        // Preloaded when the item entered the inventory, so the synchronous load is only a fallback
+        UClass* LoadedPickupClass = PickupClass.IsNull() ? nullptr : PickupClass.LoadSynchronous();
+        if (LoadedPickupClass)
+        {
+            FVector SpawnLocation = GetOwner()->GetActorLocation() + 
+                GetOwner()->GetActorForwardVector() * 100.0f;
+            
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+            
+            AItemPickup* DroppedItem = GetWorld()->SpawnActor<AItemPickup>(
+                LoadedPickupClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
+            
+            if (DroppedItem)
+            {
+                DroppedItem->SetItemData(ItemID, QuantityToDrop);
+            }
+        }
+
+        Multicast_OnItemDropped(ItemID, QuantityToDrop);
+    });
+    return true;
+}
+
+bool UInventoryComponent::UseItemInternal(int32 SlotIndex)
+{
+    if (!IsValidSlotIndex(SlotIndex) || !Inventory.Slots[SlotIndex].ItemHandle.IsValid()) return false;
+
+    const FItemHandle ItemHandle = Inventory.Slots[SlotIndex].ItemHandle;
+    const FItemDefinition* ItemData = GetItemDefinition(ItemHandle);
+    if (!ItemData || !ItemData->bUsable) return false;
+
+    const FItemEffectHandler& Handler = GetItemEffectHandler(ItemData->EffectType);
+    if (!Handler.CanApply(*this)) return false;
+
+    const int32 ConsumedQuantity = ItemData->bConsumeOnUse ? 1 : 0;
+    if (ConsumedQuantity > 0)
+    {
+        RemoveItemInternal(SlotIndex, ConsumedQuantity);
+    }
+
+    // Definitions live as long as the registry, so the pointer is safe to defer
+    DeferUntilCommit([this, &Handler, ItemData, ItemHandle, SlotIndex, ConsumedQuantity]()
+    {
+        Handler.Apply(*this, *ItemData);
+        FGameplayTelemetry::Record(ETelemetryEvent::ItemUsed, GetOwner(), nullptr, float(ConsumedQuantity), ItemHandle.Index);
+        Multicast_OnItemUsed(ItemData->ItemID, SlotIndex, ConsumedQuantity);
+    });
+    return true;
+}
+
+const UInventoryComponent::FItemEffectHandler& UInventoryComponent::GetItemEffectHandler(EItemEffectType EffectType)
+{
+    static const FItemEffectHandler Handlers[] =
+    {
+        // None
+        {
+            [](const UInventoryComponent&) { return true; },
+            [](UInventoryComponent&, const FItemDefinition&) {}
+        },
+        // Heal
+        {
+            [](const UInventoryComponent& Inventory) { return Inventory.CachedHealth != nullptr; },
+            [](UInventoryComponent& Inventory, const FItemDefinition& Item)
+            {
+                if (Inventory.CachedHealth) Inventory.CachedHealth->Heal(Item.EffectMagnitude);
+            }
+        },
+        // RestoreStamina
+        {
+            [](const UInventoryComponent& Inventory) { return Inventory.CachedStamina != nullptr; },
+            [](UInventoryComponent& Inventory, const FItemDefinition& Item)
+            {
+                if (Inventory.CachedStamina) Inventory.CachedStamina->RestoreStamina(Item.EffectMagnitude);
+            }
+        },
+        // StaminaRecoveryBoost
+        {
+            [](const UInventoryComponent& Inventory) { return Inventory.CachedStamina != nullptr; },
+            [](UInventoryComponent& Inventory, const FItemDefinition& Item)
+            {
+                if (Inventory.CachedStamina) Inventory.CachedStamina->ApplyRecoveryBoost(Item.EffectMagnitude, Item.EffectDuration);
+            }
+        },
+        // Regeneration
+        {
+            [](const UInventoryComponent& Inventory) { return Inventory.CachedHealth && UStatusEffectSubsystem::Get(&Inventory); },
+            [](UInventoryComponent& Inventory, const FItemDefinition& Item)
+            {
+                if (UStatusEffectSubsystem* StatusEffects = UStatusEffectSubsystem::Get(&Inventory))
+                {
+                    StatusEffects->ApplyEffect(Inventory.GetOwner(), EStatusEffectType::Regeneration, Item.EffectMagnitude, Item.EffectDuration);
+                }
+            }
+        },
+    };
+    static_assert(UE_ARRAY_COUNT(Handlers) == (int32)EItemEffectType::MAX, "One handler per EItemEffectType");
+
+    const int32 Index = (int32)EffectType;
+    return Handlers[Index < UE_ARRAY_COUNT(Handlers) ? Index : 0];
+}
+
+bool UInventoryComponent::SwapItemsInternal(int32 FromSlot, int32 ToSlot)
+{
+    if (!Model.Swap(FromSlot, ToSlot)) return false;
+
+    SwapSlotAttributes(FromSlot, ToSlot);
+    return true;
+}
+
+bool UInventoryComponent::MoveItemInternal(int32 FromSlot, int32 ToSlot, int32 Quantity)
+{
+    if (!IsValidSlotIndex(FromSlot) || !IsValidSlotIndex(ToSlot)) return false;
+
+    const bool bWholeStack = Quantity == Inventory.Slots[FromSlot].Quantity;
+    const bool bOntoItem = Inventory.Slots[ToSlot].ItemHandle.IsValid();
+    if (!Model.Move(FromSlot, ToSlot, Quantity)) return false;
+
+    // A whole stack takes its attributes along onto an empty slot, and loses them when merged
+    if (bWholeStack)
+    {
+        if (bOntoItem)
+        {
+            ClearSlotAttributes(FromSlot);
+        }
+        else
+        {
+            SwapSlotAttributes(FromSlot, ToSlot);
+        }
+    }
+    return true;
+}
+
+bool UInventoryComponent::CombineItemsInternal(int32 SlotA, int32 SlotB)
+{
+    if (!IsValidSlotIndex(SlotA) || !IsValidSlotIndex(SlotB) || SlotA == SlotB) return false;
+
+    const FItemHandle HandleA = Inventory.Slots[SlotA].ItemHandle;
+    const FItemHandle HandleB = Inventory.Slots[SlotB].ItemHandle;
+    const UItemRegistrySubsystem* Registry = GetItemRegistry();
+    const FCombineRecipe* Recipe = Registry ? Registry->FindCombineRecipe(HandleA, HandleB) : nullptr;
+    if (!Recipe) return false;
+
+    // The recipe stores its ingredients in handle order, not slot order
+    const bool bSlotOrder = Recipe->IngredientA == HandleA;
+    const int32 CostA = bSlotOrder ? Recipe->QuantityA : Recipe->QuantityB;
+    const int32 CostB = bSlotOrder ? Recipe->QuantityB : Recipe->QuantityA;
+    if (Inventory.Slots[SlotA].Quantity < CostA || Inventory.Slots[SlotB].Quantity < CostB) return false;
+
+    RemoveItemInternal(SlotA, CostA);
+    RemoveItemInternal(SlotB, CostB);
+
+    const FItemDefinition* ResultData = GetItemDefinition(Recipe->Result);
+    if (!ResultData) return false;
+
+    if (Inventory.Slots[SlotA].Quantity == 0 && Recipe->ResultQuantity <= ResultData->MaxStackSize
+        && Model.CanPlace(SlotA, Recipe->Result.Index, false))
+    {
+        WriteSlot(SlotA, Recipe->Result, Recipe->ResultQuantity);
+        return true;
+    }
+
+    // SlotA still holds leftovers, so the result is stowed wherever it fits. Fails the op when it does not.
+    // Added through the model directly: nothing was picked up, so no pickup event or telemetry.
+    return Model.Add(Recipe->Result.Index, Recipe->ResultQuantity);
+}
+
+bool UInventoryComponent::RotateItemInternal(int32 SlotIndex)
+{
+    return Model.Rotate(SlotIndex);
+}
+
+bool UInventoryComponent::SortAndCompactInternal(EInventorySortMode SortMode)
+{
+    const UItemRegistrySubsystem* Registry = GetItemRegistry();
+    if (!Registry || (SortMode != EInventorySortMode::Category && SortMode != EInventorySortMode::ItemID)) return false;
+
+    const bool bByCategory = SortMode == EInventorySortMode::Category;
+    const TArray<FItemHandle>& SortOrder = bByCategory ? Registry->GetItemsByCategory() : Registry->GetItemsByID();
+
+    // One pass over the slots flags the held items by sort rank, so walking the set bits yields them already ordered
+    TBitArray<> HeldRanks(false, SortOrder.Num());
+    for (const FInventorySlot& Slot : Inventory.Slots)
+    {
+        if (const FItemDefinition* ItemData = GetItemDefinition(Slot.ItemHandle))
+        {
+            HeldRanks[bByCategory ? ItemData->CategorySortRank : ItemData->IDSortRank] = true;
+        }
+    }
+
+    // Totals come from the item index, read before any slot is rewritten
+    struct FHeldItem
+    {
+        FItemHandle ItemHandle;
+        int32 Quantity;
+        int32 MaxStackSize;
+    };
+    TArray<FHeldItem, TInlineAllocator<32>> HeldItems;
+    for (TConstSetBitIterator<> It(HeldRanks); It; ++It)
+    {
+        const FItemHandle ItemHandle = SortOrder[It.GetIndex()];
+        const FItemDefinition* ItemData = GetItemDefinition(ItemHandle);
+        HeldItems.Add({ ItemHandle, Model.GetTotalQuantity(ItemHandle.Index), ItemData->MaxStackSize });
+    }
+
+    // Stacks carrying attributes hand them, in slot order, to the first new stacks of the same item.
+    // Whatever is left over belonged to stacks that were merged away.
+    TMap<int32, TArray<int32, TInlineAllocator<2>>> AttributedSlotsByItem;
+    TMap<int32, int32> NewSlotByOldSlot;
+    if (CanModifyAttributes())
+    {
+        for (int32 SlotIndex = 0; SlotIndex < Inventory.Slots.Num(); SlotIndex++)
+        {
+            const FItemAttributeEntry* Entry = Attributes.Entries.FindByPredicate([SlotIndex](const FItemAttributeEntry& Candidate)
+            {
+                return Candidate.SlotIndex == SlotIndex;
+            });
+            if (Entry)
+            {
+                AttributedSlotsByItem.FindOrAdd(Inventory.Slots[SlotIndex].ItemHandle.Index).Add(SlotIndex);
+            }
+        }
+    }
+    auto CarryAttributes = [&AttributedSlotsByItem, &NewSlotByOldSlot](FItemHandle ItemHandle, int32 NewSlot)
+    {
+        TArray<int32, TInlineAllocator<2>>* OldSlots = AttributedSlotsByItem.Find(ItemHandle.Index);
+        if (OldSlots && OldSlots->Num() > 0)
+        {
+            NewSlotByOldSlot.Add((*OldSlots)[0], NewSlot);
+            OldSlots->RemoveAt(0);
+        }
+    };
+
+    if (bUseGridLayout)
+    {
+        // Footprints differ, so release every cell and place the stacks again in order
+        for (int32 i = 0; i < Inventory.Slots.Num(); i++)
+        {
+            if (Inventory.Slots[i].ItemHandle.IsValid())
+            {
+                WriteSlot(i, FItemHandle(), 0);
+            }
+        }
+
+        for (const FHeldItem& Item : HeldItems)
+        {
+            for (int32 Remaining = Item.Quantity; Remaining > 0; )
+            {
+                bool bRotated = false;
+                const int32 SlotIndex = Model.FindPlacement(Item.ItemHandle.Index, bRotated);
+                if (SlotIndex == INDEX_NONE) return false;
+
+                const int32 StackQuantity = FMath::Min(Remaining, Item.MaxStackSize);
+                WriteSlot(SlotIndex, Item.ItemHandle, StackQuantity, bRotated);
+                CarryAttributes(Item.ItemHandle, SlotIndex);
+                Remaining -= StackQuantity;
+            }
+        }
+        RemapSlotAttributes(NewSlotByOldSlot);
+        return true;
+    }
+
+    // Full stacks first, then the remainder, filling slots from the front. Slots that already
+    // hold the right contents are not written, so they stay out of the replication change set.
+    int32 NextSlot = 0;
+    auto PlaceStack = [this, &NextSlot, &CarryAttributes](FItemHandle ItemHandle, int32 Quantity)
+    {
+        const FInventorySlot& Slot = Inventory.Slots[NextSlot];
+        if (Slot.ItemHandle != ItemHandle || Slot.Quantity != Quantity)
+        {
+            WriteSlot(NextSlot, ItemHandle, Quantity);
+        }
+        CarryAttributes(ItemHandle, NextSlot);
+        NextSlot++;
+    };
+
+    for (const FHeldItem& Item : HeldItems)
+    {
+        for (int32 Remaining = Item.Quantity; Remaining > 0; )
+        {
+            const int32 StackQuantity = FMath::Min(Remaining, Item.MaxStackSize);
+            PlaceStack(Item.ItemHandle, StackQuantity);
+            Remaining -= StackQuantity;
+        }
+    }
+
+    for (; NextSlot < Inventory.Slots.Num(); NextSlot++)
+    {
+        if (Inventory.Slots[NextSlot].ItemHandle.IsValid())
+        {
+            WriteSlot(NextSlot, FItemHandle(), 0);
+        }
+    }
+    RemapSlotAttributes(NewSlotByOldSlot);
+    return true;
+}
+
+bool UInventoryComponent::TransferItem(int32 SlotIndex, UInventoryComponent* TargetInventory, int32 Quantity)
+{
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        Server_TransferItem(SlotIndex, TargetInventory, Quantity);
+        return true;
+    }
+
+    return TransferItemInternal(SlotIndex, TargetInventory, Quantity);
+}
+
+bool UInventoryComponent::TransferItemInternal(int32 SlotIndex, UInventoryComponent* Target, int32 Quantity)
+{
+    if (!IsValidSlotIndex(SlotIndex) || !Target || Target == this || Quantity <= 0) return false;
+
+    const FInventorySlot& Slot = Inventory.Slots[SlotIndex];
+    if (!Slot.ItemHandle.IsValid()) return false;
+
+    // Both sides open their own transaction, so neither can already be inside one
+    if (bInTransaction || Target->bInTransaction)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InventoryComponent: TransferItem called during an open transaction"));
+        return false;
+    }
+
+    const FItemHandle ItemHandle = Slot.ItemHandle;
+    const int32 QuantityToTransfer = FMath::Min(Quantity, Slot.Quantity);
+
+    // Cheap rejection before either inventory is touched
+    if (Target->GetAddableQuantity(ItemHandle, QuantityToTransfer) < QuantityToTransfer) return false;
+
+    // Unique items land in a slot of their own and keep their attributes, stackables merge and drop them
+    const FItemDefinition* ItemData = GetItemDefinition(ItemHandle);
+    TArray<FItemAttributeEntry, TInlineAllocator<4>> CarriedAttributes;
+    if (ItemData && !ItemData->bStackable)
+    {
+        for (const FItemAttributeEntry& Entry : Attributes.Entries)
+        {
+            if (Entry.SlotIndex == SlotIndex)
+            {
+                CarriedAttributes.Add(Entry);
+            }
+        }
+    }
+
+    BeginTransaction();
+    Target->BeginTransaction();
+    int32 TargetSlot = INDEX_NONE;
+    if (!RemoveItemInternal(SlotIndex, QuantityToTransfer) || !Target->AddItemInternal(ItemHandle, QuantityToTransfer, &TargetSlot))
+    {
+        Target->RollbackTransaction();
+        RollbackTransaction();
+        return false;
+    }
+    for (const FItemAttributeEntry& Entry : CarriedAttributes)
+    {
+        Target->SetItemAttribute(TargetSlot, Entry.Attribute, Entry.Value);
+    }
+
+    // Each side publishes its slots as a single change set
+    Target->CommitTransaction();
+    CommitTransaction();
+    return true;
+}
+
+void UInventoryComponent::OpenContainerPage(UInventoryComponent* Container, int32 PageIndex)
+{
+    if (!Container) return;
+
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        Server_OpenContainerPage(Container, PageIndex);
+        return;
+    }
+
+    APlayerController* Viewer = GetOwningPlayerController();
+    if (!Container->CanViewPages(Viewer))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InventoryComponent: %s is not allowed to view %s"),
+            Viewer ? *Viewer->GetName() : TEXT("NULL"), *GetNameSafe(Container->GetOwner()));
+        return;
+    }
+
+    Container->AddPageViewer(Viewer, PageIndex);
+}
+
+void UInventoryComponent::CloseContainerPage(UInventoryComponent* Container, int32 PageIndex)
+{
+    if (!Container) return;
+
+    if (GetOwnerRole() < ROLE_Authority)
+    {
+        Server_CloseContainerPage(Container, PageIndex);
+        return;
+    }
+
+    Container->RemovePageViewer(GetOwningPlayerController(), PageIndex);
+}
+
+int32 UInventoryComponent::GetNumPages() const
+{
+    return bUsePagedReplication ? FMath::DivideAndRoundUp(GetTotalSlots(), FMath::Max(1, SlotsPerPage)) : 1;
+}
+
+// Additional helper functions
+FIntPoint UInventoryComponent::GetSlotFootprint(int32 SlotIndex) const
+{
+    return Model.GetSlotFootprint(SlotIndex);
+}
+
+FInventorySlot UInventoryComponent::GetSlot(int32 SlotIndex) const
+{
+    const FInventorySlot* Slot = FindSlot(SlotIndex);
+    return Slot ? *Slot : FInventorySlot();
+}
+
+void UInventoryComponent::GetOccupiedSlotIndices(TArray<int32>& OutSlotIndices) const
+{
+    OutSlotIndices.Reset(FMath::Max(0, GetTotalSlots() - Model.GetNumFreeSlots()));
+    ForEachItem([&OutSlotIndices](const FInventorySlot& Slot)
+    {
+        OutSlotIndices.Add(Slot.SlotIndex);
+    });
+}
+
+void UInventoryComponent::GetSlotIndicesInCategory(EItemCategory Category, TArray<int32>& OutSlotIndices) const
+{
+    OutSlotIndices.Reset();
+    ForEachItemInCategory(Category, [&OutSlotIndices](const FInventorySlot& Slot)
+    {
+        OutSlotIndices.Add(Slot.SlotIndex);
+    });
+}
+
+int32 UInventoryComponent::GetSlotQuantity(int32 SlotIndex) const
+{
+    const FInventorySlot* Slot = FindSlot(SlotIndex);
+    return Slot && Slot->ItemHandle.IsValid() ? Slot->Quantity : 0;
+}
+
+bool UInventoryComponent::HasItem(const FString& ItemID, int32 RequiredQuantity) const
+{
+    return GetItemCount(ItemID) >= RequiredQuantity;
+}
+
+int32 UInventoryComponent::GetItemCount(const FString& ItemID) const
+{
+    return Model.GetTotalQuantity(FindItemHandle(ItemID).Index);
+}
+
+int32 UInventoryComponent::GetAddableQuantity(const FString& ItemID) const
+{
+    return GetAddableQuantity(FindItemHandle(ItemID));
+}
+
+int32 UInventoryComponent::GetAddableQuantity(FItemHandle ItemHandle, int32 Limit) const
+{
+    return Model.GetAddableQuantity(ItemHandle.Index, Limit);
+}
+
+bool UInventoryComponent::SetItemAttribute(int32 SlotIndex, EItemAttribute Attribute, int32 Value)
+{
+    if (GetOwnerRole() < ROLE_Authority || !IsValidSlotIndex(SlotIndex) || !Inventory.Slots[SlotIndex].ItemHandle.IsValid()
+        || Attribute >= EItemAttribute::MAX)
+    {
+        return false;
+    }
+
+    SaveAttributeUndo();
+    FItemAttributeEntry* Entry = Attributes.Entries.FindByPredicate([SlotIndex, Attribute](const FItemAttributeEntry& Candidate)
+    {
+        return Candidate.SlotIndex == SlotIndex && Candidate.Attribute == Attribute;
+    });
+    if (!Entry)
+    {
+        Entry = &Attributes.Entries.AddDefaulted_GetRef();
+        Entry->SlotIndex = SlotIndex;
+        Entry->Attribute = Attribute;
+    }
+    else if (Entry->Value == Value)
+    {
+        return true;
+    }
+
+    Entry->Value = Value;
+    Attributes.MarkItemDirty(*Entry);
+    QueueSlotBroadcast(SlotIndex);
+    return true;
+}
+
+bool UInventoryComponent::RemoveItemAttribute(int32 SlotIndex, EItemAttribute Attribute)
+{
+    if (GetOwnerRole() < ROLE_Authority) return false;
+
+    const int32 EntryIndex = Attributes.Entries.IndexOfByPredicate([SlotIndex, Attribute](const FItemAttributeEntry& Candidate)
+    {
+        return Candidate.SlotIndex == SlotIndex && Candidate.Attribute == Attribute;
+    });
+    if (EntryIndex == INDEX_NONE) return false;
+
+    SaveAttributeUndo();
+    Attributes.Entries.RemoveAtSwap(EntryIndex);
+    Attributes.MarkArrayDirty();
+    QueueSlotBroadcast(SlotIndex);
+    return true;
+}
+
+int32 UInventoryComponent::GetItemAttribute(int32 SlotIndex, EItemAttribute Attribute, int32 DefaultValue) const
+{
+    // Only a handful of entries exist at any time, a scan beats keeping a map in sync
+    for (const FItemAttributeEntry& Entry : Attributes.Entries)
+    {
+        if (Entry.SlotIndex == SlotIndex && Entry.Attribute == Attribute)
+        {
+            return Entry.Value;
+        }
+    }
+    return DefaultValue;
+}
+
+TArray<FInventorySlot> UInventoryComponent::GetAllItems() const
+{
+    TArray<FInventorySlot> NonEmptySlots;
+    NonEmptySlots.Reserve(FMath::Max(0, GetTotalSlots() - Model.GetNumFreeSlots()));
+    ForEachItem([&NonEmptySlots](const FInventorySlot& Slot)
+    {
+        NonEmptySlots.Add(Slot);
+    });
+    return NonEmptySlots;
+}
+
+void UInventoryComponent::ClearInventory()
+{
+    if (GetOwnerRole() < ROLE_Authority) return;
+
+    const bool bOwnsTransaction = !bInTransaction;
+    if (bOwnsTransaction)
+    {
+        BeginTransaction();
+    }
+
+    for (int32 i = 0; i < Inventory.Slots.Num(); i++)
+    {
+        if (!Inventory.Slots[i].ItemHandle.IsValid()) continue;
+
+        ClearSlotAttributes(i);
+        WriteSlot(i, FItemHandle(), 0);
+    }
+
+    if (bOwnsTransaction)
+    {
+        CommitTransaction();
+    }
+}
+
+void UInventoryComponent::WriteSaveData(FArchive& Ar) const
+{
+    // Items are stored by ID through a small table, so saves survive reordering the item data table
+    TArray<FItemHandle, TInlineAllocator<16>> SavedItems;
+    uint32 NumEntries = 0;
+    for (const FInventorySlot& Slot : Inventory.Slots)
+    {
+        if (Slot.ItemHandle.IsValid() && Slot.Quantity > 0)
+        {
+            SavedItems.AddUnique(Slot.ItemHandle);
+            NumEntries++;
+        }
+    }
+
+    uint32 NumItems = SavedItems.Num();
+    Ar.SerializeIntPacked(NumItems);
+    for (FItemHandle ItemHandle : SavedItems)
+    {
+        const FItemDefinition* ItemData = GetItemDefinition(ItemHandle);
+        FString ItemID = ItemData ? ItemData->ItemID : FString();
+        Ar << ItemID;
+    }
+
+    Ar.SerializeIntPacked(NumEntries);
+    for (const FInventorySlot& Slot : Inventory.Slots)
+    {
+        if (!Slot.ItemHandle.IsValid() || Slot.Quantity <= 0) continue;
+
+        uint32 SlotIndex = (uint32(Slot.SlotIndex) << 1) | (Slot.bRotated ? 1 : 0);
+        uint32 SavedItemIndex = SavedItems.IndexOfByKey(Slot.ItemHandle);
+        uint32 Quantity = Slot.Quantity;
+        Ar.SerializeIntPacked(SlotIndex);
+        Ar.SerializeIntPacked(SavedItemIndex);
+        Ar.SerializeIntPacked(Quantity);
+    }
+
+    uint32 NumAttributes = Attributes.Entries.Num();
+    Ar.SerializeIntPacked(NumAttributes);
+    for (const FItemAttributeEntry& Entry : Attributes.Entries)
+    {
+        uint32 SlotIndex = Entry.SlotIndex;
+        uint8 Attribute = (uint8)Entry.Attribute;
+        int32 Value = Entry.Value;
+        Ar.SerializeIntPacked(SlotIndex);
+        Ar << Attribute;
+        Ar << Value;
+    }
+}
+
+bool UInventoryComponent::ReadSaveData(FArchive& Ar, uint16 Version)
+{
+    if (GetOwnerRole() < ROLE_Authority || Version > SaveDataVersion) return false;
+
+    uint32 NumItems = 0;
+    Ar.SerializeIntPacked(NumItems);
+    if (Ar.IsError() || NumItems > uint32(Ar.TotalSize())) return false;
+
+    // Items removed from the table since the save resolve to invalid handles and are dropped
+    TArray<FItemHandle, TInlineAllocator<16>> SavedItems;
+    for (uint32 i = 0; i < NumItems && !Ar.IsError(); i++)
+    {
+        FString ItemID;
+        Ar << ItemID;
+        SavedItems.Add(FindItemHandle(ItemID));
+    }
+
+    uint32 NumEntries = 0;
+    Ar.SerializeIntPacked(NumEntries);
+    if (Ar.IsError()) return false;
+
+    // Replaces the current contents in one transaction, so listeners see the loaded state only
+    const bool bOwnsTransaction = !bInTransaction;
+    if (bOwnsTransaction)
+    {
+        BeginTransaction();
+    }
+
+    for (int32 i = 0; i < Inventory.Slots.Num(); i++)
+    {
+        if (Inventory.Slots[i].ItemHandle.IsValid())
+        {
+            ClearSlotAttributes(i);
+            WriteSlot(i, FItemHandle(), 0);
+        }
+    }
+
+    for (uint32 i = 0; i < NumEntries; i++)
+    {
+        uint32 SlotIndex = 0;
+        uint32 SavedItemIndex = 0;
+        uint32 Quantity = 0;
+        Ar.SerializeIntPacked(SlotIndex);
+        Ar.SerializeIntPacked(SavedItemIndex);
+        Ar.SerializeIntPacked(Quantity);
+        if (Ar.IsError())
+        {
+            if (bOwnsTransaction)
+            {
+                RollbackTransaction();
+            }
+            return false;
+        }
+
+        bool bRotated = false;
+        if (Version >= 2)
+        {
+            bRotated = (SlotIndex & 1) != 0;
+            SlotIndex >>= 1;
+        }
+
+        if (!IsValidSlotIndex(SlotIndex) || !SavedItems.IsValidIndex(SavedItemIndex)) continue;
+
+        const FItemDefinition* ItemData = GetItemDefinition(SavedItems[SavedItemIndex]);
+        if (!ItemData) continue;
+
+        const int32 MaxQuantity = ItemData->bStackable ? ItemData->MaxStackSize : 1;
+        WriteSlot(SlotIndex, SavedItems[SavedItemIndex], FMath::Clamp(int32(Quantity), 1, MaxQuantity), bRotated);
+    }
+
+    // Attributes of slots whose item was dropped are skipped by SetItemAttribute
+    uint32 NumAttributes = 0;
+    if (Version >= 3)
+    {
+        Ar.SerializeIntPacked(NumAttributes);
+    }
+    for (uint32 i = 0; i < NumAttributes && !Ar.IsError(); i++)
+    {
+        uint32 SlotIndex = 0;
+        uint8 Attribute = 0;
+        int32 Value = 0;
+        Ar.SerializeIntPacked(SlotIndex);
+        Ar << Attribute;
+        Ar << Value;
+        if (!Ar.IsError() && Attribute < (uint8)EItemAttribute::MAX)
+        {
+            SetItemAttribute(int32(SlotIndex), (EItemAttribute)Attribute, Value);
+        }
+    }
+    if (Ar.IsError())
+    {
+        if (bOwnsTransaction)
+        {
+            RollbackTransaction();
+        }
+        return false;
+    }
+
+    // Saved footprints were written without fit checks and may overlap if the layout changed since
+    Model.MarkGridDirty();
+
+    if (bOwnsTransaction)
+    {
+        CommitTransaction();
+    }
+    return true;
+}
+
+// Server RPC Implementations
+void UInventoryComponent::Server_ApplyInventoryOps_Implementation(const TArray<FInventoryOp>& Ops, int32 PredictionKey)
+{
+    if (HasServerOnlyOps(Ops))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InventoryComponent: Rejected client batch with server-only ops"));
+    }
+    else
+    {
+        ApplyInventoryOps(Ops);
+    }
+
+    // Acknowledged whether the batch succeeded or not; a rejected batch makes the client roll back.
+    // The key replicates in the same update as the slots it changed.
+    LastProcessedPredictionKey = FMath::Max(LastProcessedPredictionKey, PredictionKey);
+}
+
+void UInventoryComponent::Server_OpenContainerPage_Implementation(UInventoryComponent* Container, int32 PageIndex)
+{
+    OpenContainerPage(Container, PageIndex);
+}
+
+void UInventoryComponent::Server_CloseContainerPage_Implementation(UInventoryComponent* Container, int32 PageIndex)
+{
+    CloseContainerPage(Container, PageIndex);
 }
 
 void UInventoryComponent::Server_TransferItem_Implementation(int32 SlotIndex, UInventoryComponent* TargetInventory, int32 Quantity)
 {
+    // Clients may only fill their own containers and ones they could open
+    APlayerController* Requester = GetOwningPlayerController();
+    if (!TargetInventory || !TargetInventory->CanViewPages(Requester))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InventoryComponent: %s is not allowed to transfer into %s"),
+            Requester ? *Requester->GetName() : TEXT("NULL"), *GetNameSafe(TargetInventory ? TargetInventory->GetOwner() : nullptr));
+        return;
+    }
+
     TransferItem(SlotIndex, TargetInventory, Quantity);
 }
 
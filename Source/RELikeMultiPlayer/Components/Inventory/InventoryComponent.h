@@ -5,93 +5,259 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "Engine/DataTable.h"
+#include "../../Items/Data/ItemData.h"
+#include "InventoryModel.h"
 #include "InventoryComponent.generated.h"
 
-// Item Categories
-UENUM(BlueprintType)
-enum class EItemCategory : uint8
-{
-    None         UMETA(DisplayName = "None"),
-    Medical      UMETA(DisplayName = "Medical"),
-    Tools        UMETA(DisplayName = "Tools"),
-    Weapons      UMETA(DisplayName = "Weapons"),
-    Resources    UMETA(DisplayName = "Resources"),
-    Lore         UMETA(DisplayName = "Lore")
-};
+class UInventoryComponent;
+struct FInventoryList;
 
-// Item Data Structure
+// Inventory Slot
 USTRUCT(BlueprintType)
-struct FItemData : public FTableRowBase
+struct FInventorySlot : public FFastArraySerializerItem
 {
     GENERATED_BODY()
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    UPROPERTY(BlueprintReadOnly)
     FString ItemID;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    FString ItemName;
+    UPROPERTY(BlueprintReadOnly)
+    int32 Quantity;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    FString Description;
+    UPROPERTY(BlueprintReadOnly)
+    int32 SlotIndex;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    EItemCategory Category;
+    UPROPERTY()
+    FItemHandle ItemHandle;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    UTexture2D* Icon;
+    // Grid inventories: the footprint is turned 90 degrees
+    UPROPERTY(BlueprintReadOnly)
+    bool bRotated = false;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    bool bStackable = false;
+    FInventorySlot()
+    {
+        ItemID = "";
+        Quantity = 0;
+        SlotIndex = -1;
+    }
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    int32 MaxStackSize = 1;
+    // Fast array callbacks, called on clients for each slot that changed in a replication update
+    void PreReplicatedRemove(const FInventoryList& InArraySerializer);
+    void PostReplicatedAdd(const FInventoryList& InArraySerializer);
+    void PostReplicatedChange(const FInventoryList& InArraySerializer);
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-    TSubclassOf<class AItemPickup> PickupClass;
+    // Sends only the slot index, the packed item handle (with the rotation bit) and quantity. Receivers rebuild ItemID in the callbacks.
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
 
-    FItemData()
+template<>
+struct TStructOpsTypeTraits<FInventorySlot> : public TStructOpsTypeTraitsBase2<FInventorySlot>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
+
+// Delta-replicated slot container. Only slots marked dirty are sent over the wire.
+USTRUCT(BlueprintType)
+struct FInventoryList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    FInventoryList()
+        : OwnerComponent(nullptr)
+    {
+    }
+
+    FInventoryList(UInventoryComponent* InOwnerComponent)
+        : OwnerComponent(InOwnerComponent)
     {
-        ItemID = "";
-        ItemName = "Unknown Item";
-        Description = "";
-        Category = EItemCategory::None;
-        Icon = nullptr;
-        bStackable = false;
-        MaxStackSize = 1;
     }
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FInventorySlot, FInventoryList>(Slots, DeltaParms, *this);
+    }
+
+    UPROPERTY(BlueprintReadOnly)
+    TArray<FInventorySlot> Slots;
+
+    UPROPERTY(NotReplicated)
+    TObjectPtr<UInventoryComponent> OwnerComponent;
 };
 
-// Inventory Slot
+template<>
+struct TStructOpsTypeTraits<FInventoryList> : public TStructOpsTypeTraitsBase2<FInventoryList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+// Per-instance values only some items carry
+UENUM(BlueprintType)
+enum class EItemAttribute : uint8
+{
+    Durability   UMETA(DisplayName = "Durability"),
+    LoadedAmmo   UMETA(DisplayName = "Loaded Ammo"),
+    MAX          UMETA(Hidden)
+};
+
+struct FItemAttributeList;
+
+// One attribute of the item in a slot
 USTRUCT(BlueprintType)
-struct FInventorySlot
+struct FItemAttributeEntry : public FFastArraySerializerItem
 {
     GENERATED_BODY()
 
     UPROPERTY(BlueprintReadOnly)
-    FString ItemID;
+    int32 SlotIndex = INDEX_NONE;
 
     UPROPERTY(BlueprintReadOnly)
-    int32 Quantity;
+    EItemAttribute Attribute = EItemAttribute::Durability;
 
     UPROPERTY(BlueprintReadOnly)
-    int32 SlotIndex;
+    int32 Value = 0;
 
-    FInventorySlot()
+    // Fast array callbacks, forwarded to the inventory as slot changes
+    void PreReplicatedRemove(const FItemAttributeList& InArraySerializer);
+    void PostReplicatedAdd(const FItemAttributeList& InArraySerializer);
+    void PostReplicatedChange(const FItemAttributeList& InArraySerializer);
+};
+
+// Sparse side table of item attributes keyed by slot. Only slots whose item carries attributes have entries,
+// so slots stay small and the table only replicates when an attribute changes.
+USTRUCT()
+struct FItemAttributeList : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    FItemAttributeList()
+        : OwnerComponent(nullptr)
     {
-        ItemID = "";
-        Quantity = 0;
-        SlotIndex = -1;
     }
+
+    FItemAttributeList(UInventoryComponent* InOwnerComponent)
+        : OwnerComponent(InOwnerComponent)
+    {
+    }
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FItemAttributeEntry, FItemAttributeList>(Entries, DeltaParms, *this);
+    }
+
+    UPROPERTY()
+    TArray<FItemAttributeEntry> Entries;
+
+    UPROPERTY(NotReplicated)
+    TObjectPtr<UInventoryComponent> OwnerComponent;
+};
+
+template<>
+struct TStructOpsTypeTraits<FItemAttributeList> : public TStructOpsTypeTraitsBase2<FItemAttributeList>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+// Inventory operation types that can be batched into a single server call
+UENUM(BlueprintType)
+enum class EInventoryOpType : uint8
+{
+    Add          UMETA(DisplayName = "Add"),       // Add Quantity of ItemHandle
+    Remove       UMETA(DisplayName = "Remove"),    // Discard Quantity from SlotA
+    Drop         UMETA(DisplayName = "Drop"),      // Drop Quantity from SlotA into the world
+    Use          UMETA(DisplayName = "Use"),       // Use the item in SlotA
+    Swap         UMETA(DisplayName = "Swap"),      // Swap the contents of SlotA and SlotB
+    Move         UMETA(DisplayName = "Move"),      // Move Quantity from SlotA onto SlotB (split or merge)
+    Combine      UMETA(DisplayName = "Combine"),   // Combine SlotA with SlotB using the registry recipe
+    Rotate       UMETA(DisplayName = "Rotate"),    // Turn the item in SlotA 90 degrees in place (grid layout)
+    Sort         UMETA(DisplayName = "Sort")       // Merge stacks and reorder every slot, SlotA holds the EInventorySortMode
+};
+
+UENUM(BlueprintType)
+enum class EInventorySortMode : uint8
+{
+    Category     UMETA(DisplayName = "Category"),  // By category, then item ID
+    ItemID       UMETA(DisplayName = "Item ID")
+};
+
+// One inventory operation
+USTRUCT(BlueprintType)
+struct FInventoryOp
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+    EInventoryOpType Type = EInventoryOpType::Swap;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+    int32 SlotA = -1;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+    int32 SlotB = -1;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+    int32 Quantity = 1;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+    FItemHandle ItemHandle;
+
+    static FInventoryOp MakeAdd(FItemHandle InItemHandle, int32 InQuantity);
+    static FInventoryOp MakeRemove(int32 InSlot, int32 InQuantity);
+    static FInventoryOp MakeDrop(int32 InSlot, int32 InQuantity);
+    static FInventoryOp MakeUse(int32 InSlot);
+    static FInventoryOp MakeSwap(int32 InFromSlot, int32 InToSlot);
+    static FInventoryOp MakeMove(int32 InFromSlot, int32 InToSlot, int32 InQuantity);
+    static FInventoryOp MakeCombine(int32 InSlotA, int32 InSlotB);
+    static FInventoryOp MakeRotate(int32 InSlot);
+    static FInventoryOp MakeSort(EInventorySortMode InSortMode);
+};
+
+// Small public view of an inventory, replicated to everyone the owner is relevant to.
+// Observers read this instead of the slots, which only go to the owner (or to page viewers when paged).
+USTRUCT(BlueprintType)
+struct FInventorySummary
+{
+    GENERATED_BODY()
+
+    // Incremented on every committed change
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 Version = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 OccupiedSlots = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    int32 TotalSlots = 0;
+
+    // Holds at least one item flagged bIsKeyItem
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    bool bHasKeyItem = false;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryUpdated, int32, SlotIndex, const FInventorySlot&, Slot);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryChanged, const TArray<int32>&, ChangedSlots);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemPickedUp, const FString&, ItemID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnItemDropped, const FString&, ItemID, int32, Quantity);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnItemUsed, const FString&, ItemID, int32, SlotIndex, int32, Quantity);
 
 // Forward declarations
 class UHealthComponent;
+class UStaminaComponent;
+class UInventoryPage;
+class APawn;
+class APlayerController;
+class UItemRegistrySubsystem;
+struct FItemDefinition;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class RELIKEMULTIPLAYER_API UInventoryComponent : public UActorComponent
@@ -102,10 +268,16 @@ public:
 	// Sets default values for this component's properties
 	UInventoryComponent();
 
+#if WITH_DEV_AUTOMATION_TESTS
+    friend struct FGameplayTestAccess;
+#endif
+
 	protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 
     // Inventory Properties
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
@@ -114,26 +286,215 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
     int32 InventoryRows = 2;
 
+    // Fallback table used only when the item registry has no table configured
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
     UDataTable* ItemDataTable;
 
+    UPROPERTY(Transient)
+    TObjectPtr<UItemRegistrySubsystem> ItemRegistry;
+
+    // Effect targets on the owner, resolved in BeginPlay
+    UPROPERTY(Transient)
+    TObjectPtr<UHealthComponent> CachedHealth;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UStaminaComponent> CachedStamina;
+
+    // Large shared containers: slots replicate per page, only to connections that opened the page.
+    // The owning actor must replicate using the registered subobject list.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
+    bool bUsePagedReplication = false;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory", meta = (EditCondition = "bUsePagedReplication", ClampMin = "1"))
+    int32 SlotsPerPage = 24;
+
+    // Players other than the owner may only open pages while their pawn is this close to the container
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory", meta = (EditCondition = "bUsePagedReplication", ClampMin = "0"))
+    float MaxViewerDistance = 400.0f;
+
+    // Unpaged slots only go to the owning connection; everyone else gets Summary.
+    // Turn off for small unpaged containers that every player browses.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory", meta = (EditCondition = "!bUsePagedReplication"))
+    bool bReplicateSlotsToOwnerOnly = true;
+
+    // Attache case layout: items cover GridWidth x GridHeight cells of the InventoryColumns x InventoryRows grid,
+    // anchored at their slot. At most 64 columns, not used with paged replication.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
+    bool bUseGridLayout = false;
+
+    // Upper bound on operations accepted in one ApplyInventoryOps call
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
+    int32 MaxOpsPerBatch = 64;
+
     UPROPERTY(ReplicatedUsing = OnRep_Inventory, BlueprintReadOnly, Category = "Inventory")
-    TArray<FInventorySlot> Inventory;
+    FInventoryList Inventory;
+
+    // Newest client prediction key the server has applied (or rejected), sent to the owner only
+    UPROPERTY(ReplicatedUsing = OnRep_LastProcessedPredictionKey)
+    int32 LastProcessedPredictionKey = 0;
+
+    // Durability, loaded ammo and the like, for the few slots whose item has any. Same audience as the slots.
+    UPROPERTY(Replicated)
+    FItemAttributeList Attributes;
+
+    // Replicated to everyone, server maintained
+    UPROPERTY(Replicated, BlueprintReadOnly, Category = "Inventory")
+    FInventorySummary Summary;
+
+    void UpdateSummary();
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UInventoryPage>> Pages;
+
+    // Server only: pages each viewer has open, and the pawn they were opened with
+    struct FPageViewer
+    {
+        TBitArray<> OpenPages;
+        TWeakObjectPtr<APawn> Pawn;
+    };
+    TMap<TWeakObjectPtr<APlayerController>, FPageViewer> ViewerPages;
 
-    // Replication
     UFUNCTION()
     void OnRep_Inventory();
 
+    UFUNCTION()
+    void OnRep_LastProcessedPredictionKey();
+
+    // Replication
+    friend struct FInventorySlot;
+    friend struct FItemAttributeEntry;
+    void OnSlotReplicatedAdd(const FInventorySlot& Slot);
+    void OnSlotReplicatedChange(const FInventorySlot& Slot);
+    void OnSlotReplicatedRemove(const FInventorySlot& Slot);
+    void ReceiveAuthoritativeSlot(const FInventorySlot& Slot);
+    void RestoreReplicatedSlot(FInventorySlot& Slot) const;
+
+    // Sets a slot's contents through the model. Quantity 0 empties the slot.
+    void WriteSlot(int32 SlotIndex, FItemHandle ItemHandle, int32 Quantity, bool bRotated = false);
+    void SetSlotContents(FInventorySlot& Slot, FItemHandle ItemHandle, int32 Quantity, bool bRotated) const;
+
+    // Mirrors a model write into Inventory. Unless only mirroring, the write is also recorded for undo and published.
+    void HandleModelSlotWritten(int32 SlotIndex);
+    bool bMirrorModelWritesOnly = false;
+
+    // Flags a slot for delta replication and notifies local listeners, deferred while a transaction is open
+    void MarkSlotDirty(int32 SlotIndex);
+    void PublishSlot(int32 SlotIndex);
+
+    // Server-side operation execution. A failing op rolls back every op before it in the same call.
+    bool ExecuteOp(const FInventoryOp& Op) { return ExecuteOps(MakeArrayView(&Op, 1)); }
+    bool ExecuteOps(TConstArrayView<FInventoryOp> Ops);
+    bool ApplyOp(const FInventoryOp& Op);
+    bool AddItemInternal(FItemHandle ItemHandle, int32 Quantity, int32* OutLastSlot = nullptr);
+    bool RemoveItemInternal(int32 SlotIndex, int32 Quantity);
+    bool DropItemInternal(int32 SlotIndex, int32 Quantity);
+    bool UseItemInternal(int32 SlotIndex);
+    bool SwapItemsInternal(int32 FromSlot, int32 ToSlot);
+    bool MoveItemInternal(int32 FromSlot, int32 ToSlot, int32 Quantity);
+    bool CombineItemsInternal(int32 SlotA, int32 SlotB);
+    bool RotateItemInternal(int32 SlotIndex);
+    bool SortAndCompactInternal(EInventorySortMode SortMode);
+
+    // Attributes follow their item when slot contents move. Server only, predicted ops leave them alone.
+    bool CanModifyAttributes() const { return Attributes.Entries.Num() > 0 && GetOwnerRole() == ROLE_Authority; }
+    void ClearSlotAttributes(int32 SlotIndex);
+    void SwapSlotAttributes(int32 SlotA, int32 SlotB);
+    void RemapSlotAttributes(const TMap<int32, int32>& NewSlotByOldSlot);
+    void SaveAttributeUndo();
+
+    // Transactions record slot writes and publish them together on commit, or undo them on rollback
+    void BeginTransaction();
+    void CommitTransaction();
+    void RollbackTransaction();
+
+    // Runs Action on commit (immediately outside a transaction). Used for side effects that cannot be undone.
+    // Predicted ops never run them, the server does.
+    void DeferUntilCommit(TFunction<void()>&& Action);
+
+    // Client prediction: apply locally, send with a key, and rebuild from the authoritative slots as keys are acknowledged
+    bool PredictOps(TConstArrayView<FInventoryOp> Ops);
+
+    // Ops clients may not request: items only enter an inventory through server code such as pickups
+    static bool HasServerOnlyOps(TConstArrayView<FInventoryOp> Ops);
+    void ReconcilePredictions();
+
+    // Change notifications: slots touched this frame are collected and delivered together at the end of the frame
+    void QueueSlotBroadcast(int32 SlotIndex);
+    TBitArray<> PendingChangeMask;
+    TArray<int32> PendingChangedSlots;
+
+    // Slot rules, item index and grid occupancy. Inventory mirrors its slots for replication and Blueprint.
+    FInventoryModel Model;
+
+    struct FSlotContents
+    {
+        int32 SlotIndex;
+        FItemHandle ItemHandle;
+        int32 Quantity;
+        bool bRotated;
+    };
+
+    bool bInTransaction = false;
+    TArray<FSlotContents> TransactionUndo;
+    TArray<int32> TransactionDirtySlots;
+    TBitArray<> TransactionDirtyMask;
+    TArray<TFunction<void()>> TransactionCommitActions;
+
+    // The attribute table is small, so a transaction copies it whole before its first attribute change
+    TOptional<TArray<FItemAttributeEntry>> TransactionAttributeUndo;
+
+    struct FPendingInventoryPrediction
+    {
+        int32 PredictionKey;
+        TArray<FInventoryOp> Ops;
+    };
+
+    bool bPredicting = false;
+    int32 LastPredictionKey = 0;
+    TArray<FPendingInventoryPrediction> PendingPredictions;
+    TArray<FSlotContents> AuthoritativeSlots;
+
+    // Authoritative slots arrived under pending predictions, so the next reconcile must rebuild
+    bool bAuthoritativeSlotsChanged = false;
+
+    // One entry per EItemEffectType. CanApply runs before the item is consumed, Apply on commit.
+    struct FItemEffectHandler
+    {
+        bool (*CanApply)(const UInventoryComponent& Inventory);
+        void (*Apply)(UInventoryComponent& Inventory, const FItemDefinition& Item);
+    };
+
+    static const FItemEffectHandler& GetItemEffectHandler(EItemEffectType EffectType);
+
+    // Paging
+    void InitializePages();
+    bool AddPageViewer(APlayerController* Viewer, int32 PageIndex);
+    void RemovePageViewer(APlayerController* Viewer, int32 PageIndex);
+    bool CanViewPages(const APlayerController* Viewer) const;
+
+    // Takes the viewer out of every page group it joined. The caller removes the entry.
+    void ClosePageViewer(APlayerController* Viewer, const FPageViewer& PageViewer);
+
+    // A viewer's controller or pawn went away, so their pages close
+    UFUNCTION()
+    void OnPageViewerDestroyed(AActor* DestroyedActor);
+    void RemoveStalePageViewers();
+    APlayerController* GetOwningPlayerController() const;
+
     // Internal Functions
     int32 GetTotalSlots() const { return InventoryColumns * InventoryRows; }
     bool IsValidSlotIndex(int32 SlotIndex) const;
-    FItemData* GetItemData(const FString& ItemID) const;
-    int32 FindFirstEmptySlot() const;
-    int32 FindItemSlot(const FString& ItemID) const;
-    int32 FindPartialStackSlot(const FString& ItemID) const;
+    UItemRegistrySubsystem* GetItemRegistry() const;
+    FItemHandle FindItemHandle(const FString& ItemID) const;
+    const FItemDefinition* GetItemDefinition(FItemHandle ItemHandle) const;
+    EItemCategory GetItemCategory(FItemHandle ItemHandle) const;
+
+    // Moves Quantity out of SlotIndex into Target as one transaction on each side, committed together
+    bool TransferItemInternal(int32 SlotIndex, UInventoryComponent* Target, int32 Quantity);
 
 public:
     // Public Functions
+    // Server only; clients get items through pickups
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     bool AddItem(const FString& ItemID, int32 Quantity = 1);
 
@@ -149,25 +510,142 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     bool SwapItems(int32 FromSlot, int32 ToSlot);
 
+    // Combines two stacks into the recipe result, which takes SlotA's place when it empties
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool CombineItems(int32 SlotA, int32 SlotB);
+
+    // Merges partial stacks and packs every item to the front in sort order, as one change set
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool SortAndCompact(EInventorySortMode SortMode = EInventorySortMode::Category);
+
+    // Grid layout: turns the item 90 degrees around its anchor if the new footprint fits
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool RotateItem(int32 SlotIndex);
+
+    // Grid layout: cells covered by the item anchored at SlotIndex, zero for empty slots
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    FIntPoint GetSlotFootprint(int32 SlotIndex) const;
+
+    // Applies Ops in order as one all-or-nothing transaction with a single server call.
+    // Clients cannot send Add ops.
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool ApplyInventoryOps(const TArray<FInventoryOp>& Ops);
+
+    // Resolved entirely on the server, so the client never needs the target's slots.
+    // All or nothing: both inventories change together, or neither does.
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     bool TransferItem(int32 SlotIndex, UInventoryComponent* TargetInventory, int32 Quantity = 1);
 
+    // Starts replicating one page of a paged Container to this component's player
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void OpenContainerPage(UInventoryComponent* Container, int32 PageIndex);
+
+    // Stops replicating a page, or every page with INDEX_NONE
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void CloseContainerPage(UInventoryComponent* Container, int32 PageIndex = -1);
+
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    int32 GetNumPages() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    FInventorySummary GetSummary() const { return Summary; }
+
+    // Copies the slot, prefer FindSlot from C++
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     FInventorySlot GetSlot(int32 SlotIndex) const;
 
+    // In-place views for C++ callers, valid until the inventory next changes
+    const FInventorySlot* FindSlot(int32 SlotIndex) const
+    {
+        return IsValidSlotIndex(SlotIndex) ? &Inventory.Slots[SlotIndex] : nullptr;
+    }
+
+    // Every slot, empty ones included
+    TConstArrayView<FInventorySlot> GetSlots() const { return Inventory.Slots; }
+
+    // Calls Function(const FInventorySlot&) for each occupied slot, in slot order
+    template<typename FunctionType>
+    void ForEachItem(FunctionType&& Function) const
+    {
+        for (const FInventorySlot& Slot : Inventory.Slots)
+        {
+            if (Slot.ItemHandle.IsValid())
+            {
+                Function(Slot);
+            }
+        }
+    }
+
+    template<typename FunctionType>
+    void ForEachItemInCategory(EItemCategory Category, FunctionType&& Function) const
+    {
+        for (const FInventorySlot& Slot : Inventory.Slots)
+        {
+            if (Slot.ItemHandle.IsValid() && GetItemCategory(Slot.ItemHandle) == Category)
+            {
+                Function(Slot);
+            }
+        }
+    }
+
+    // Blueprint wrappers over the views. They return slot indices, not slot copies, so no ItemID string is
+    // copied; the Blueprint out parameter still copies the index array once per call.
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void GetOccupiedSlotIndices(TArray<int32>& OutSlotIndices) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void GetSlotIndicesInCategory(EItemCategory Category, TArray<int32>& OutSlotIndices) const;
+
+    // Reads one field of a slot without copying it, zero for empty or invalid slots
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    int32 GetSlotQuantity(int32 SlotIndex) const;
+
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     bool HasItem(const FString& ItemID, int32 RequiredQuantity = 1) const;
 
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     int32 GetItemCount(const FString& ItemID) const;
 
+    // Server only. The slot must hold an item, and its attributes are dropped when it empties.
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool SetItemAttribute(int32 SlotIndex, EItemAttribute Attribute, int32 Value);
+
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    bool RemoveItemAttribute(int32 SlotIndex, EItemAttribute Attribute);
+
+    // DefaultValue when the item in the slot does not carry the attribute
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    int32 GetItemAttribute(int32 SlotIndex, EItemAttribute Attribute, int32 DefaultValue = 0) const;
+
+    // How many of an item AddItem would accept right now, without changing anything
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    int32 GetAddableQuantity(const FString& ItemID) const;
+
+    // Stops counting at Limit. Read from the item index in slot layout; grid layout places copies on a scratch grid.
+    int32 GetAddableQuantity(FItemHandle ItemHandle, int32 Limit = MAX_int32) const;
+
+    // Copies every occupied slot into a new array per call, see GetOccupiedSlotIndices
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     TArray<FInventorySlot> GetAllItems() const;
 
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     void ClearInventory();
 
+    // Persistence, see UPlayerSaveSubsystem. Server only.
+    // Version 2 stores the grid rotation with each slot, version 3 the item attributes
+    static constexpr uint16 SaveDataVersion = 3;
+    void WriteSaveData(FArchive& Ar) const;
+    bool ReadSaveData(FArchive& Ar, uint16 Version);
+
+    // Delivers this frame's pending change notifications now instead of at the end of the frame
+    void FlushChangeNotifications();
+
     // Delegates
+    // Once per frame with every slot that changed in it, in index order
+    UPROPERTY(BlueprintAssignable, Category = "Inventory")
+    FOnInventoryChanged OnInventoryChanged;
+
+    // Per-slot form of OnInventoryChanged, fired from the same end of frame flush
     UPROPERTY(BlueprintAssignable, Category = "Inventory")
     FOnInventoryUpdated OnInventoryUpdated;
 
@@ -183,19 +661,13 @@ public:
 private:
     // Server RPCs
     UFUNCTION(Server, Reliable)
-    void Server_AddItem(const FString& ItemID, int32 Quantity);
-
-    UFUNCTION(Server, Reliable)
-    void Server_RemoveItem(int32 SlotIndex, int32 Quantity);
-
-    UFUNCTION(Server, Reliable)
-    void Server_DropItem(int32 SlotIndex, int32 Quantity);
+    void Server_ApplyInventoryOps(const TArray<FInventoryOp>& Ops, int32 PredictionKey);
 
     UFUNCTION(Server, Reliable)
-    void Server_UseItem(int32 SlotIndex);
+    void Server_OpenContainerPage(UInventoryComponent* Container, int32 PageIndex);
 
     UFUNCTION(Server, Reliable)
-    void Server_SwapItems(int32 FromSlot, int32 ToSlot);
+    void Server_CloseContainerPage(UInventoryComponent* Container, int32 PageIndex);
 
     UFUNCTION(Server, Reliable)
     void Server_TransferItem(int32 SlotIndex, UInventoryComponent* TargetInventory, int32 Quantity);
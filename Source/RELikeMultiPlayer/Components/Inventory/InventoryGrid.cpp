@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InventoryGrid.h"
+
+void FInventoryGrid::Reset(int32 InColumns, int32 InRows)
+{
+    Columns = FMath::Clamp(InColumns, 0, MaxColumns);
+    Rows = FMath::Max(InRows, 0);
+    ColumnMask = Columns > 0 ? MakeSpan(0, Columns) : 0;
+
+    Footprints.Reset();
+    Footprints.SetNumZeroed(Columns * Rows);
+
+    RowBits.Reset();
+    RowBits.SetNumZeroed(Rows);
+    bDirty = false;
+}
+
+void FInventoryGrid::UpdateSlot(int32 SlotIndex, FIntPoint Size)
+{
+    if (!Footprints.IsValidIndex(SlotIndex)) return;
+
+    FIntPoint& Footprint = Footprints[SlotIndex];
+    if (Footprint == Size) return;
+
+    if (!bDirty)
+    {
+        WriteFootprint(SlotIndex, Footprint, false);
+        WriteFootprint(SlotIndex, Size, true);
+    }
+    Footprint = Size;
+}
+
+bool FInventoryGrid::Fits(int32 SlotIndex, FIntPoint Size, int32 IgnoreSlotA, int32 IgnoreSlotB) const
+{
+    if (!Footprints.IsValidIndex(SlotIndex) || Size.X <= 0 || Size.Y <= 0) return false;
+
+    const int32 Column = SlotIndex % Columns;
+    const int32 Row = SlotIndex / Columns;
+    if (Column + Size.X > Columns || Row + Size.Y > Rows) return false;
+
+    EnsureBuilt();
+
+    const uint64 Span = MakeSpan(Column, Size.X);
+    for (int32 R = Row; R < Row + Size.Y; R++)
+    {
+        const uint64 Ignored = GetFootprintRowBits(IgnoreSlotA, R) | GetFootprintRowBits(IgnoreSlotB, R);
+        if (RowBits[R] & ~Ignored & Span) return false;
+    }
+    return true;
+}
+
+int32 FInventoryGrid::FindPlacement(FIntPoint Size) const
+{
+    if (Size.X <= 0 || Size.Y <= 0 || Size.X > Columns || Size.Y > Rows) return INDEX_NONE;
+
+    EnsureBuilt();
+
+    for (int32 Row = 0; Row + Size.Y <= Rows; Row++)
+    {
+        uint64 Occupied = 0;
+        for (int32 R = Row; R < Row + Size.Y; R++)
+        {
+            Occupied |= RowBits[R];
+        }
+
+        // Bit c survives when columns c to c + Width - 1 are all free. Free has no bits past the last column,
+        // so runs that would cross the right edge drop out on their own.
+        const uint64 Free = ~Occupied & ColumnMask;
+        uint64 Runs = Free;
+        for (int32 Shift = 1; Shift < Size.X && Runs != 0; Shift++)
+        {
+            Runs &= Free >> Shift;
+        }
+
+        if (Runs != 0)
+        {
+            return Row * Columns + int32(FMath::CountTrailingZeros64(Runs));
+        }
+    }
+    return INDEX_NONE;
+}
+
+void FInventoryGrid::EnsureBuilt() const
+{
+    if (!bDirty) return;
+
+    for (uint64& Bits : RowBits)
+    {
+        Bits = 0;
+    }
+    for (int32 SlotIndex = 0; SlotIndex < Footprints.Num(); SlotIndex++)
+    {
+        WriteFootprint(SlotIndex, Footprints[SlotIndex], true);
+    }
+    bDirty = false;
+}
+
+void FInventoryGrid::WriteFootprint(int32 SlotIndex, FIntPoint Size, bool bOccupied) const
+{
+    if (Size.X <= 0 || Size.Y <= 0) return;
+
+    // Footprints that hang off the grid (e.g. loaded from an older layout) are clipped
+    const int32 Column = SlotIndex % Columns;
+    const int32 Row = SlotIndex / Columns;
+    const uint64 Span = MakeSpan(Column, FMath::Min(Size.X, Columns - Column)) & ColumnMask;
+    const int32 LastRow = FMath::Min(Row + Size.Y, Rows);
+    for (int32 R = Row; R < LastRow; R++)
+    {
+        RowBits[R] = bOccupied ? (RowBits[R] | Span) : (RowBits[R] & ~Span);
+    }
+}
+
+uint64 FInventoryGrid::GetFootprintRowBits(int32 SlotIndex, int32 Row) const
+{
+    if (!Footprints.IsValidIndex(SlotIndex)) return 0;
+
+    const FIntPoint Size = Footprints[SlotIndex];
+    const int32 Column = SlotIndex % Columns;
+    const int32 AnchorRow = SlotIndex / Columns;
+    if (Size.X <= 0 || Row < AnchorRow || Row >= AnchorRow + Size.Y) return 0;
+
+    return MakeSpan(Column, FMath::Min(Size.X, Columns - Column)) & ColumnMask;
+}
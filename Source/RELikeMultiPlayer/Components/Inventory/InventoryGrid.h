@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Cell occupancy of a grid inventory, one uint64 bitmask per row.
+ * Items are recorded by the slot they are anchored at (their top-left cell) and the size of their footprint.
+ * Fit checks and placement searches are row-wise bit operations instead of per-cell loops.
+ */
+class RELIKEMULTIPLAYER_API FInventoryGrid
+{
+public:
+    static constexpr int32 MaxColumns = 64;
+
+    void Reset(int32 InColumns, int32 InRows);
+
+    // Replaces the footprint recorded for the item anchored at SlotIndex. A zero size clears it.
+    void UpdateSlot(int32 SlotIndex, FIntPoint Size);
+
+    // Footprints recorded out of order (rollback, replication) may overlap on the way and clear each other's
+    // cells, so those paths mark the grid dirty and it is rebuilt from the footprints on the next query
+    void MarkDirty() { bDirty = true; }
+
+    // Whether a Size footprint anchored at SlotIndex lies inside the grid on free cells.
+    // Cells of the ignored slots count as free, for items that move or rotate in place.
+    bool Fits(int32 SlotIndex, FIntPoint Size, int32 IgnoreSlotA = INDEX_NONE, int32 IgnoreSlotB = INDEX_NONE) const;
+
+    // Lowest anchor, in row-major order, with room for a Size footprint, or INDEX_NONE
+    int32 FindPlacement(FIntPoint Size) const;
+
+    FIntPoint GetFootprint(int32 SlotIndex) const
+    {
+        return Footprints.IsValidIndex(SlotIndex) ? Footprints[SlotIndex] : FIntPoint::ZeroValue;
+    }
+
+private:
+    void EnsureBuilt() const;
+    void WriteFootprint(int32 SlotIndex, FIntPoint Size, bool bOccupied) const;
+
+    // Bits of the footprint anchored at SlotIndex within Row
+    uint64 GetFootprintRowBits(int32 SlotIndex, int32 Row) const;
+
+    static uint64 MakeSpan(int32 Column, int32 Width)
+    {
+        return (Width >= 64 ? ~uint64(0) : ((uint64(1) << Width) - 1)) << Column;
+    }
+
+    int32 Columns = 0;
+    int32 Rows = 0;
+    uint64 ColumnMask = 0;
+
+    TArray<FIntPoint> Footprints;
+
+    // Derived from Footprints
+    mutable TArray<uint64> RowBits;
+    mutable bool bDirty = false;
+};
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InventoryItemIndex.h"
+
+void FInventoryItemIndex::Reset(int32 NumSlots, int32 NumItems)
+{
+    SlotEntries.Reset();
+    SlotEntries.SetNum(NumSlots);
+
+    ItemEntries.Reset();
+    ItemEntries.SetNum(NumItems);
+
+    FreeSlots.Init(true, NumSlots);
+    NumFreeSlots = NumSlots;
+    FirstFreeHint = 0;
+}
+
+void FInventoryItemIndex::UpdateSlot(int32 SlotIndex, int32 ItemIndex, int32 Quantity, int32 MaxStackSize)
+{
+    if (SlotIndex < 0) return;
+
+    // Clients learn the slot count from replication, so grow on demand
+    if (SlotIndex >= SlotEntries.Num())
+    {
+        const int32 OldNum = SlotEntries.Num();
+        SlotEntries.SetNum(SlotIndex + 1);
+        FreeSlots.Add(true, SlotIndex + 1 - OldNum);
+        NumFreeSlots += SlotIndex + 1 - OldNum;
+        FirstFreeHint = FMath::Min(FirstFreeHint, OldNum);
+    }
+
+    FSlotEntry NewEntry;
+    if (ItemIndex != INDEX_NONE && Quantity > 0)
+    {
+        NewEntry.ItemIndex = ItemIndex;
+        NewEntry.Quantity = Quantity;
+        NewEntry.MaxStackSize = FMath::Max(1, MaxStackSize);
+    }
+
+    RemoveFromIndex(SlotIndex, SlotEntries[SlotIndex]);
+    AddToIndex(SlotIndex, NewEntry);
+    SlotEntries[SlotIndex] = NewEntry;
+}
+
+int32 FInventoryItemIndex::FindPartialStack(int32 ItemIndex) const
+{
+    if (!ItemEntries.IsValidIndex(ItemIndex)) return INDEX_NONE;
+
+    int32 LowestSlot = INDEX_NONE;
+    for (int32 SlotIndex : ItemEntries[ItemIndex].PartialStacks)
+    {
+        if (LowestSlot == INDEX_NONE || SlotIndex < LowestSlot)
+        {
+            LowestSlot = SlotIndex;
+        }
+    }
+    return LowestSlot;
+}
+
+int32 FInventoryItemIndex::FindFreeSlot() const
+{
+    if (NumFreeSlots == 0) return INDEX_NONE;
+
+    // Word-wise bit scan starting at the hint, so this touches a handful of words even for storage-sized inventories
+    const int32 SlotIndex = FreeSlots.FindFrom(true, FirstFreeHint);
+    FirstFreeHint = SlotIndex == INDEX_NONE ? FreeSlots.Num() : SlotIndex;
+    return SlotIndex;
+}
+
+void FInventoryItemIndex::AddToIndex(int32 SlotIndex, const FSlotEntry& Entry)
+{
+    if (Entry.ItemIndex == INDEX_NONE)
+    {
+        SetSlotFree(SlotIndex, true);
+        return;
+    }
+
+    SetSlotFree(SlotIndex, false);
+
+    if (Entry.ItemIndex >= ItemEntries.Num())
+    {
+        ItemEntries.SetNum(Entry.ItemIndex + 1);
+    }
+
+    FItemEntry& ItemEntry = ItemEntries[Entry.ItemIndex];
+    ItemEntry.TotalQuantity += Entry.Quantity;
+
+    if (Entry.Quantity < Entry.MaxStackSize)
+    {
+        ItemEntry.PartialStacks.Add(SlotIndex);
+        ItemEntry.PartialStackSpace += Entry.MaxStackSize - Entry.Quantity;
+    }
+}
+
+void FInventoryItemIndex::RemoveFromIndex(int32 SlotIndex, const FSlotEntry& Entry)
+{
+    if (Entry.ItemIndex == INDEX_NONE) return;
+
+    FItemEntry& ItemEntry = ItemEntries[Entry.ItemIndex];
+    ItemEntry.TotalQuantity -= Entry.Quantity;
+
+    if (Entry.Quantity < Entry.MaxStackSize)
+    {
+        ItemEntry.PartialStacks.RemoveSingleSwap(SlotIndex);
+        ItemEntry.PartialStackSpace -= Entry.MaxStackSize - Entry.Quantity;
+    }
+}
+
+void FInventoryItemIndex::SetSlotFree(int32 SlotIndex, bool bFree)
+{
+    if (FreeSlots[SlotIndex] == bFree) return;
+
+    FreeSlots[SlotIndex] = bFree;
+    NumFreeSlots += bFree ? 1 : -1;
+
+    if (bFree)
+    {
+        FirstFreeHint = FMath::Min(FirstFreeHint, SlotIndex);
+    }
+}
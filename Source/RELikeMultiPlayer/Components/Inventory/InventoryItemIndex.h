@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Running index over the slots of one inventory: total quantity per item, partially filled
+ * stacks per item and free slots. Updated incrementally whenever a slot changes, so stack,
+ * count and capacity queries do not scan the slot array.
+ * Items are addressed by their registry index (FItemHandle::Index).
+ */
+class RELIKEMULTIPLAYER_API FInventoryItemIndex
+{
+public:
+    void Reset(int32 NumSlots, int32 NumItems);
+
+    // Replaces whatever the index recorded for SlotIndex with the new contents
+    void UpdateSlot(int32 SlotIndex, int32 ItemIndex, int32 Quantity, int32 MaxStackSize);
+
+    int32 GetTotalQuantity(int32 ItemIndex) const
+    {
+        return ItemEntries.IsValidIndex(ItemIndex) ? ItemEntries[ItemIndex].TotalQuantity : 0;
+    }
+
+    // Free space left across all partial stacks of an item
+    int32 GetPartialStackSpace(int32 ItemIndex) const
+    {
+        return ItemEntries.IsValidIndex(ItemIndex) ? ItemEntries[ItemIndex].PartialStackSpace : 0;
+    }
+
+    // Lowest partially filled stack of an item, or INDEX_NONE
+    int32 FindPartialStack(int32 ItemIndex) const;
+
+    // Lowest empty slot, or INDEX_NONE
+    int32 FindFreeSlot() const;
+
+    int32 GetNumFreeSlots() const { return NumFreeSlots; }
+
+private:
+    struct FSlotEntry
+    {
+        int32 ItemIndex = INDEX_NONE;
+        int32 Quantity = 0;
+        int32 MaxStackSize = 1;
+    };
+
+    struct FItemEntry
+    {
+        int32 TotalQuantity = 0;
+        int32 PartialStackSpace = 0;
+
+        // Usually zero or one entry, stacks are always topped up before a new one is started
+        TArray<int32, TInlineAllocator<2>> PartialStacks;
+    };
+
+    void AddToIndex(int32 SlotIndex, const FSlotEntry& Entry);
+    void RemoveFromIndex(int32 SlotIndex, const FSlotEntry& Entry);
+    void SetSlotFree(int32 SlotIndex, bool bFree);
+
+    TArray<FSlotEntry> SlotEntries;
+    TArray<FItemEntry> ItemEntries;
+
+    // One bit per slot, set when the slot is empty
+    TBitArray<> FreeSlots;
+    int32 NumFreeSlots = 0;
+
+    // No free slot exists below this index
+    mutable int32 FirstFreeHint = 0;
+};
@@ -0,0 +1,278 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InventoryModel.h"
+
+void FInventoryModel::Reset(int32 InColumns, int32 InRows, bool bInGridLayout, TConstArrayView<FInventoryModelItem> InItems)
+{
+    Columns = FMath::Max(InColumns, 1);
+    bGridLayout = bInGridLayout;
+    Items = InItems;
+
+    const int32 NumSlots = FMath::Max(InColumns, 0) * FMath::Max(InRows, 0);
+    Slots.Reset();
+    Slots.SetNum(NumSlots);
+    Index.Reset(NumSlots, Items.Num());
+    if (bGridLayout)
+    {
+        Grid.Reset(InColumns, InRows);
+    }
+}
+
+int32 FInventoryModel::GetAddableQuantity(int32 ItemIndex, int32 Limit) const
+{
+    const FInventoryModelItem* Item = FindItem(ItemIndex);
+    if (!Item || Limit <= 0) return 0;
+
+    const int64 PerSlot = Item->bStackable ? Item->MaxStackSize : 1;
+    int64 Addable = Item->bStackable ? Index.GetPartialStackSpace(ItemIndex) : 0;
+
+    if (!bGridLayout)
+    {
+        Addable += int64(Index.GetNumFreeSlots()) * PerSlot;
+        return int32(FMath::Min<int64>(Addable, Limit));
+    }
+
+    // Free slots do not mean free cells in a grid, so place footprints on a copy until one no longer fits
+    const FIntPoint Size = GetFootprint(ItemIndex, false);
+    const FIntPoint RotatedSize(Size.Y, Size.X);
+    FInventoryGrid Scratch = Grid;
+    while (Addable < Limit)
+    {
+        FIntPoint Placed = Size;
+        int32 Anchor = Scratch.FindPlacement(Size);
+        if (Anchor == INDEX_NONE && Size.X != Size.Y)
+        {
+            Placed = RotatedSize;
+            Anchor = Scratch.FindPlacement(RotatedSize);
+        }
+        if (Anchor == INDEX_NONE) break;
+
+        Scratch.UpdateSlot(Anchor, Placed);
+        Addable += PerSlot;
+    }
+    return int32(FMath::Min<int64>(Addable, Limit));
+}
+
+FIntPoint FInventoryModel::GetFootprint(int32 ItemIndex, bool bRotated) const
+{
+    const FInventoryModelItem* Item = FindItem(ItemIndex);
+    if (!Item) return FIntPoint::ZeroValue;
+
+    return bRotated ? FIntPoint(Item->GridSize.Y, Item->GridSize.X) : Item->GridSize;
+}
+
+FIntPoint FInventoryModel::GetSlotFootprint(int32 SlotIndex) const
+{
+    if (!IsValidSlot(SlotIndex) || Slots[SlotIndex].IsEmpty()) return FIntPoint::ZeroValue;
+
+    const FInventoryModelSlot& Slot = Slots[SlotIndex];
+    return bGridLayout ? GetFootprint(Slot.ItemIndex, Slot.bRotated) : FIntPoint(1, 1);
+}
+
+bool FInventoryModel::CanPlace(int32 SlotIndex, int32 ItemIndex, bool bRotated, int32 IgnoreSlotA, int32 IgnoreSlotB) const
+{
+    return !bGridLayout || Grid.Fits(SlotIndex, GetFootprint(ItemIndex, bRotated), IgnoreSlotA, IgnoreSlotB);
+}
+
+int32 FInventoryModel::FindPlacement(int32 ItemIndex, bool& bOutRotated) const
+{
+    bOutRotated = false;
+    if (!bGridLayout) return Index.FindFreeSlot();
+
+    const FIntPoint Size = GetFootprint(ItemIndex, false);
+    int32 SlotIndex = Grid.FindPlacement(Size);
+    if (SlotIndex == INDEX_NONE && Size.X != Size.Y)
+    {
+        SlotIndex = Grid.FindPlacement(FIntPoint(Size.Y, Size.X));
+        bOutRotated = SlotIndex != INDEX_NONE;
+    }
+    return SlotIndex;
+}
+
+bool FInventoryModel::Add(int32 ItemIndex, int32 Quantity, int32* OutLastSlot)
+{
+    const FInventoryModelItem* Item = FindItem(ItemIndex);
+    if (!Item || Quantity <= 0) return false;
+
+    // Check the room up front, so a failed add never leaves stacks half filled.
+    // A single new stack only needs one placement; more than that in a grid needs the scratch search.
+    const int32 PerSlot = Item->bStackable ? Item->MaxStackSize : 1;
+    const int32 PartialSpace = Item->bStackable ? Index.GetPartialStackSpace(ItemIndex) : 0;
+    const int32 NewStacks = FMath::DivideAndRoundUp(FMath::Max(Quantity - PartialSpace, 0), PerSlot);
+    if (NewStacks > 0)
+    {
+        bool bRotated = false;
+        const bool bFits = !bGridLayout ? NewStacks <= Index.GetNumFreeSlots()
+            : NewStacks == 1 ? FindPlacement(ItemIndex, bRotated) != INDEX_NONE
+            : GetAddableQuantity(ItemIndex, Quantity) >= Quantity;
+        if (!bFits) return false;
+    }
+
+    int32 RemainingQuantity = Quantity;
+
+    // If stackable, top up existing stacks first
+    while (Item->bStackable && RemainingQuantity > 0)
+    {
+        const int32 PartialSlot = Index.FindPartialStack(ItemIndex);
+        if (PartialSlot == INDEX_NONE) break;
+
+        const FInventoryModelSlot& Slot = Slots[PartialSlot];
+        const int32 QuantityToAdd = FMath::Min(RemainingQuantity, Item->MaxStackSize - Slot.Quantity);
+        WriteSlot(PartialSlot, ItemIndex, Slot.Quantity + QuantityToAdd, Slot.bRotated);
+        RemainingQuantity -= QuantityToAdd;
+        if (OutLastSlot)
+        {
+            *OutLastSlot = PartialSlot;
+        }
+    }
+
+    // Then start new stacks
+    while (RemainingQuantity > 0)
+    {
+        bool bRotated = false;
+        const int32 EmptySlot = FindPlacement(ItemIndex, bRotated);
+        if (!ensure(EmptySlot != INDEX_NONE)) return false;
+
+        const int32 QuantityToAdd = FMath::Min(RemainingQuantity, PerSlot);
+        WriteSlot(EmptySlot, ItemIndex, QuantityToAdd, bRotated);
+        RemainingQuantity -= QuantityToAdd;
+        if (OutLastSlot)
+        {
+            *OutLastSlot = EmptySlot;
+        }
+    }
+    return true;
+}
+
+bool FInventoryModel::Remove(int32 SlotIndex, int32 Quantity)
+{
+    if (!IsValidSlot(SlotIndex) || Slots[SlotIndex].IsEmpty() || Quantity <= 0) return false;
+
+    const FInventoryModelSlot& Slot = Slots[SlotIndex];
+    WriteSlot(SlotIndex, Slot.ItemIndex, Slot.Quantity > Quantity ? Slot.Quantity - Quantity : 0, Slot.bRotated);
+    return true;
+}
+
+bool FInventoryModel::Swap(int32 SlotA, int32 SlotB)
+{
+    if (!IsValidSlot(SlotA) || !IsValidSlot(SlotB)) return false;
+
+    // Swap contents only, each slot keeps its index
+    const FInventoryModelSlot From = Slots[SlotA];
+    const FInventoryModelSlot To = Slots[SlotB];
+
+    if (bGridLayout && SlotA != SlotB)
+    {
+        // Both items must fit at the other's anchor, ignoring where they are now, without covering each other
+        if (!From.IsEmpty() && !CanPlace(SlotB, From.ItemIndex, From.bRotated, SlotA, SlotB)) return false;
+        if (!To.IsEmpty() && !CanPlace(SlotA, To.ItemIndex, To.bRotated, SlotA, SlotB)) return false;
+        if (!From.IsEmpty() && !To.IsEmpty())
+        {
+            const FIntPoint FromMin(SlotB % Columns, SlotB / Columns);
+            const FIntPoint FromMax = FromMin + GetFootprint(From.ItemIndex, From.bRotated);
+            const FIntPoint ToMin(SlotA % Columns, SlotA / Columns);
+            const FIntPoint ToMax = ToMin + GetFootprint(To.ItemIndex, To.bRotated);
+            if (FromMin.X < ToMax.X && ToMin.X < FromMax.X && FromMin.Y < ToMax.Y && ToMin.Y < FromMax.Y) return false;
+        }
+
+        // Release the source footprint first, so no cell is cleared after another item has claimed it
+        WriteSlot(SlotA, INDEX_NONE, 0);
+    }
+
+    WriteSlot(SlotB, From.ItemIndex, From.Quantity, From.bRotated);
+    WriteSlot(SlotA, To.ItemIndex, To.Quantity, To.bRotated);
+    return true;
+}
+
+bool FInventoryModel::Move(int32 FromSlot, int32 ToSlot, int32 Quantity)
+{
+    if (!IsValidSlot(FromSlot) || !IsValidSlot(ToSlot) || FromSlot == ToSlot) return false;
+
+    const FInventoryModelSlot From = Slots[FromSlot];
+    const FInventoryModelSlot To = Slots[ToSlot];
+    if (From.IsEmpty() || Quantity <= 0 || Quantity > From.Quantity) return false;
+
+    int32 NewToQuantity = Quantity;
+    bool bToRotated = From.bRotated;
+    if (To.IsEmpty())
+    {
+        // A full move frees the source cells, a split keeps them
+        const int32 IgnoreSlot = Quantity == From.Quantity ? FromSlot : INDEX_NONE;
+        if (!CanPlace(ToSlot, From.ItemIndex, From.bRotated, IgnoreSlot)) return false;
+    }
+    else
+    {
+        // Merging needs the same stackable item and enough room, different items are swapped instead
+        const FInventoryModelItem* Item = FindItem(From.ItemIndex);
+        if (To.ItemIndex != From.ItemIndex || !Item || !Item->bStackable) return false;
+        if (To.Quantity + Quantity > Item->MaxStackSize) return false;
+
+        NewToQuantity += To.Quantity;
+        bToRotated = To.bRotated;
+    }
+
+    WriteSlot(FromSlot, From.ItemIndex, From.Quantity - Quantity, From.bRotated);
+    WriteSlot(ToSlot, From.ItemIndex, NewToQuantity, bToRotated);
+    return true;
+}
+
+bool FInventoryModel::Rotate(int32 SlotIndex)
+{
+    if (!bGridLayout || !IsValidSlot(SlotIndex) || Slots[SlotIndex].IsEmpty()) return false;
+
+    const FInventoryModelSlot& Slot = Slots[SlotIndex];
+    if (!CanPlace(SlotIndex, Slot.ItemIndex, !Slot.bRotated, SlotIndex)) return false;
+
+    WriteSlot(SlotIndex, Slot.ItemIndex, Slot.Quantity, !Slot.bRotated);
+    return true;
+}
+
+bool FInventoryModel::Transfer(FInventoryModel& Source, int32 SlotIndex, FInventoryModel& Target, int32 Quantity, int32* OutTargetSlot)
+{
+    if (&Source == &Target || !Source.IsValidSlot(SlotIndex) || Source.Slots[SlotIndex].IsEmpty() || Quantity <= 0) return false;
+
+    const int32 ItemIndex = Source.Slots[SlotIndex].ItemIndex;
+    const int32 QuantityToTransfer = FMath::Min(Quantity, Source.Slots[SlotIndex].Quantity);
+
+    // Checked first, so neither side changes when the target is full
+    if (Target.GetAddableQuantity(ItemIndex, QuantityToTransfer) < QuantityToTransfer) return false;
+
+    const FInventoryModelSlot SourceSlot = Source.Slots[SlotIndex];
+    Source.Remove(SlotIndex, QuantityToTransfer);
+    if (!Target.Add(ItemIndex, QuantityToTransfer, OutTargetSlot))
+    {
+        // Add checks its room before writing, so restoring the source slot undoes the whole transfer
+        Source.WriteSlot(SlotIndex, SourceSlot.ItemIndex, SourceSlot.Quantity, SourceSlot.bRotated);
+        return false;
+    }
+    return true;
+}
+
+void FInventoryModel::WriteSlot(int32 SlotIndex, int32 ItemIndex, int32 Quantity, bool bRotated)
+{
+    if (!IsValidSlot(SlotIndex)) return;
+
+    const FInventoryModelItem* Item = Quantity > 0 ? FindItem(ItemIndex) : nullptr;
+    FInventoryModelSlot& Slot = Slots[SlotIndex];
+    if (Item)
+    {
+        Slot.ItemIndex = ItemIndex;
+        Slot.Quantity = Quantity;
+        Slot.bRotated = bRotated;
+    }
+    else
+    {
+        Slot = FInventoryModelSlot();
+    }
+
+    Index.UpdateSlot(SlotIndex, Slot.ItemIndex, Slot.Quantity, Item ? Item->MaxStackSize : 1);
+    if (bGridLayout)
+    {
+        Grid.UpdateSlot(SlotIndex, Item ? GetFootprint(ItemIndex, bRotated) : FIntPoint::ZeroValue);
+    }
+
+    if (OnSlotWritten)
+    {
+        OnSlotWritten(SlotIndex);
+    }
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemIndex.h"
+#include "InventoryGrid.h"
+#include "../../Items/Registry/InventoryModelItem.h"
+
+// Contents of one slot. Empty slots hold INDEX_NONE and no quantity.
+struct FInventoryModelSlot
+{
+    int32 ItemIndex = INDEX_NONE;
+    int32 Quantity = 0;
+    bool bRotated = false;
+
+    bool IsEmpty() const { return Quantity <= 0; }
+};
+
+/**
+ * Slot rules of an inventory with no engine dependency beyond Core: stacking, removal, swaps, moves,
+ * grid placement and transfers. UInventoryComponent wraps one and adds transactions, prediction and
+ * replication; containers, vendors, tests and save tooling can use it on its own, without a world.
+ *
+ * Every rule is all or nothing: a call that returns false has not changed any slot.
+ */
+class RELIKEMULTIPLAYER_API FInventoryModel
+{
+public:
+    // Items must outlive the model, e.g. the item registry's table
+    void Reset(int32 InColumns, int32 InRows, bool bInGridLayout, TConstArrayView<FInventoryModelItem> InItems);
+
+    // Called after each slot write, with the slot's contents already updated
+    TFunction<void(int32 SlotIndex)> OnSlotWritten;
+
+    // Queries
+    int32 GetNumSlots() const { return Slots.Num(); }
+    bool IsValidSlot(int32 SlotIndex) const { return Slots.IsValidIndex(SlotIndex); }
+    const FInventoryModelSlot& GetSlot(int32 SlotIndex) const { return Slots[SlotIndex]; }
+    TConstArrayView<FInventoryModelSlot> GetSlots() const { return Slots; }
+    bool UsesGridLayout() const { return bGridLayout; }
+
+    const FInventoryModelItem* FindItem(int32 ItemIndex) const
+    {
+        return Items.IsValidIndex(ItemIndex) ? &Items[ItemIndex] : nullptr;
+    }
+
+    int32 GetTotalQuantity(int32 ItemIndex) const { return Index.GetTotalQuantity(ItemIndex); }
+    int32 GetNumFreeSlots() const { return Index.GetNumFreeSlots(); }
+    int32 FindFreeSlot() const { return Index.FindFreeSlot(); }
+    int32 FindPartialStack(int32 ItemIndex) const { return Index.FindPartialStack(ItemIndex); }
+
+    // How many of an item Add would accept, stopping at Limit. Constant time in slot layout.
+    int32 GetAddableQuantity(int32 ItemIndex, int32 Limit = MAX_int32) const;
+
+    FIntPoint GetFootprint(int32 ItemIndex, bool bRotated) const;
+    FIntPoint GetSlotFootprint(int32 SlotIndex) const;
+
+    // Grid layout: whether the item fits anchored at SlotIndex, and the lowest anchor where it does.
+    // Both always succeed in slot layout.
+    bool CanPlace(int32 SlotIndex, int32 ItemIndex, bool bRotated, int32 IgnoreSlotA = INDEX_NONE, int32 IgnoreSlotB = INDEX_NONE) const;
+    int32 FindPlacement(int32 ItemIndex, bool& bOutRotated) const;
+
+    // Rules
+    bool Add(int32 ItemIndex, int32 Quantity, int32* OutLastSlot = nullptr);
+    bool Remove(int32 SlotIndex, int32 Quantity);
+    bool Swap(int32 SlotA, int32 SlotB);
+    bool Move(int32 FromSlot, int32 ToSlot, int32 Quantity);
+    bool Rotate(int32 SlotIndex);
+
+    // Moves Quantity from a slot of Source into Target. Both models must share the same items.
+    // Neither model changes when the target cannot take the whole quantity.
+    static bool Transfer(FInventoryModel& Source, int32 SlotIndex, FInventoryModel& Target, int32 Quantity, int32* OutTargetSlot = nullptr);
+
+    // Unchecked write, for rules that live outside the model and for replicated or restored state.
+    // Quantity 0 empties the slot.
+    void WriteSlot(int32 SlotIndex, int32 ItemIndex, int32 Quantity, bool bRotated = false);
+
+    // See FInventoryGrid::MarkDirty
+    void MarkGridDirty() { Grid.MarkDirty(); }
+
+private:
+    int32 Columns = 0;
+    bool bGridLayout = false;
+
+    TConstArrayView<FInventoryModelItem> Items;
+    TArray<FInventoryModelSlot> Slots;
+
+    // Derived from Slots
+    FInventoryItemIndex Index;
+    FInventoryGrid Grid;
+};
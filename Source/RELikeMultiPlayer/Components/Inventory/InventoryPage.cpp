@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InventoryPage.h"
+#include "Net/UnrealNetwork.h"
+
+UInventoryPage::UInventoryPage()
+{
+}
+
+void UInventoryPage::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    // Replicated slot callbacks go straight to the inventory that owns the page
+    Slots.OwnerComponent = GetTypedOuter<UInventoryComponent>();
+}
+
+void UInventoryPage::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(UInventoryPage, FirstSlotIndex);
+    DOREPLIFETIME(UInventoryPage, Slots);
+}
+
+void UInventoryPage::InitializePage(int32 InPageIndex, int32 InFirstSlotIndex, int32 InNumSlots)
+{
+    PageIndex = InPageIndex;
+    FirstSlotIndex = InFirstSlotIndex;
+    NetGroup = FName(*FString::Printf(TEXT("InventoryPage_%u"), GetUniqueID()));
+
+    Slots.Slots.SetNum(InNumSlots);
+    for (int32 i = 0; i < InNumSlots; i++)
+    {
+        Slots.Slots[i].SlotIndex = FirstSlotIndex + i;
+        Slots.MarkItemDirty(Slots.Slots[i]);
+    }
+}
+
+void UInventoryPage::MirrorSlot(const FInventorySlot& Slot)
+{
+    FInventorySlot& PageSlot = Slots.Slots[Slot.SlotIndex - FirstSlotIndex];
+    PageSlot.ItemID = Slot.ItemID;
+    PageSlot.ItemHandle = Slot.ItemHandle;
+    PageSlot.Quantity = Slot.Quantity;
+    PageSlot.bRotated = Slot.bRotated;
+    Slots.MarkItemDirty(PageSlot);
+}
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "InventoryComponent.h"
+#include "InventoryPage.generated.h"
+
+// A fixed range of slots of a paged inventory, replicated as its own subobject
+// only to the connections that have the page open
+UCLASS()
+class RELIKEMULTIPLAYER_API UInventoryPage : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UInventoryPage();
+
+    virtual void PostInitProperties() override;
+    virtual bool IsSupportedForNetworking() const override { return true; }
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    // Server setup: creates the page's slots and its net condition group
+    void InitializePage(int32 InPageIndex, int32 InFirstSlotIndex, int32 InNumSlots);
+
+    // Copies a slot's contents from the owning inventory and marks it for replication
+    void MirrorSlot(const FInventorySlot& Slot);
+
+    int32 GetPageIndex() const { return PageIndex; }
+    FName GetNetGroup() const { return NetGroup; }
+
+    UPROPERTY(Replicated)
+    int32 FirstSlotIndex = 0;
+
+    UPROPERTY(Replicated)
+    FInventoryList Slots;
+
+private:
+    int32 PageIndex = INDEX_NONE;
+    FName NetGroup;
+};
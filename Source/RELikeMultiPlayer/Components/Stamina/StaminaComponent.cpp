@@ -1,4 +1,5 @@
 #include "StaminaComponent.h"
+#include "../../Core/Telemetry/GameplayTelemetry.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/Engine.h"
@@ -76,7 +77,7 @@ void UStaminaComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(UStaminaComponent, CurrentStamina);
+    DOREPLIFETIME(UStaminaComponent, ReplicatedStamina);
     DOREPLIFETIME(UStaminaComponent, CurrentStaminaState);
     
     UE_LOG(LogTemp, VeryVerbose, TEXT("StaminaComponent: Replication properties registered"));
@@ -84,6 +85,7 @@ void UStaminaComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 
 void UStaminaComponent::OnRep_Stamina()
 {
+    CurrentStamina = ReplicatedStamina.ToValue(MaxStamina);
     UE_LOG(LogTemp, Log, TEXT("StaminaComponent OnRep_Stamina: %f"), CurrentStamina);
     OnStaminaChanged.Broadcast(CurrentStamina);
 }
@@ -101,6 +103,14 @@ void UStaminaComponent::OnRep_StaminaState()
 
 void UStaminaComponent::UpdateStaminaState()
 {
+    // A change held back by the threshold is sent once the timer runs out, in case stamina stops here.
+    // While stamina keeps moving this also bounds how stale clients get.
+    if (!ReplicatedStamina.Update(CurrentStamina, MaxStamina, ReplicationSteps, ReplicationThreshold) && ReplicationThreshold > 1
+        && GetOwnerRole() == ROLE_Authority && !GetWorld()->GetTimerManager().IsTimerActive(ReplicationSettleTimerHandle))
+    {
+        GetWorld()->GetTimerManager().SetTimer(ReplicationSettleTimerHandle, this, &UStaminaComponent::SettleReplicatedStamina, ReplicationSettleDelay, false);
+    }
+
     EStaminaState OldState = CurrentStaminaState;
 
     if (CurrentStamina <= 0)
@@ -123,6 +133,7 @@ void UStaminaComponent::UpdateStaminaState()
 
         if (CurrentStaminaState == EStaminaState::Exhausted)
         {
+            FGameplayTelemetry::Record(ETelemetryEvent::Exhausted, GetOwner());
             OnExhausted.Broadcast();
             ApplyExhaustionEffects();
             
@@ -150,7 +161,7 @@ void UStaminaComponent::HandleStaminaRegeneration(float DeltaTime)
     if (CurrentStamina >= MaxStamina) return;
 
     float OldStamina = CurrentStamina;
-    CurrentStamina = FMath::Clamp(CurrentStamina + (RecoveryRatePerSecond * DeltaTime), 0.0f, MaxStamina);
+    CurrentStamina = FMath::Clamp(CurrentStamina + (RecoveryRatePerSecond * RecoveryMultiplier * DeltaTime), 0.0f, MaxStamina);
 
     if (CurrentStamina != OldStamina)
     {
@@ -214,6 +225,26 @@ void UStaminaComponent::RemoveExhaustionEffects()
     MovementComp->MaxWalkSpeed = 500.0f;
 }
 
+void UStaminaComponent::WriteSaveData(FArchive& Ar) const
+{
+    float Stamina = CurrentStamina;
+    Ar << Stamina;
+}
+
+bool UStaminaComponent::ReadSaveData(FArchive& Ar, uint16 Version)
+{
+    if (GetOwnerRole() < ROLE_Authority || Version > SaveDataVersion) return false;
+
+    float Stamina = 0.0f;
+    Ar << Stamina;
+    if (Ar.IsError() || !FMath::IsFinite(Stamina)) return false;
+
+    CurrentStamina = FMath::Clamp(Stamina, 0.0f, MaxStamina);
+    UpdateStaminaState();
+    OnStaminaChanged.Broadcast(CurrentStamina);
+    return true;
+}
+
 bool UStaminaComponent::ConsumeStamina(float Amount)
 {
     if (GetOwnerRole() < ROLE_Authority)
@@ -237,6 +268,40 @@ bool UStaminaComponent::ConsumeStamina(float Amount)
     return CurrentStamina > 0;
 }
 
+void UStaminaComponent::RestoreStamina(float Amount)
+{
+    if (GetOwnerRole() < ROLE_Authority || Amount <= 0) return;
+
+    float OldStamina = CurrentStamina;
+    CurrentStamina = FMath::Clamp(CurrentStamina + Amount, 0.0f, MaxStamina);
+
+    if (CurrentStamina != OldStamina)
+    {
+        OnStaminaChanged.Broadcast(CurrentStamina);
+        UpdateStaminaState();
+    }
+}
+
+void UStaminaComponent::ApplyRecoveryBoost(float Multiplier, float Duration)
+{
+    if (GetOwnerRole() < ROLE_Authority || Multiplier <= 0 || Duration <= 0) return;
+
+    // A new boost replaces the running one
+    RecoveryMultiplier = Multiplier;
+    GetWorld()->GetTimerManager().SetTimer(
+        RecoveryBoostTimerHandle,
+        this,
+        &UStaminaComponent::EndRecoveryBoost,
+        Duration,
+        false
+    );
+}
+
+void UStaminaComponent::EndRecoveryBoost()
+{
+    RecoveryMultiplier = 1.0f;
+}
+
 void UStaminaComponent::StartSprinting()
 {
     if (GetOwnerRole() < ROLE_Authority)
@@ -345,6 +410,11 @@ bool UStaminaComponent::PerformStruggle()
     return true;
 }
 
+void UStaminaComponent::SettleReplicatedStamina()
+{
+    ReplicatedStamina.Update(CurrentStamina, MaxStamina, ReplicationSteps, 1);
+}
+
 void UStaminaComponent::EndExhaustionRecoveryDelay()
 {
     bCanRegenerate = true;
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "../../Core/Net/QuantizedVital.h"
 #include "StaminaComponent.generated.h"
 
 UENUM(BlueprintType)
@@ -29,6 +30,10 @@ public:
 	// Sets default values for this component's properties
 	UStaminaComponent();
 
+#if WITH_DEV_AUTOMATION_TESTS
+    friend struct FGameplayTestAccess;
+#endif
+
 	protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -39,9 +44,25 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stamina")
     float MaxStamina = 100.0f;
 
-    UPROPERTY(ReplicatedUsing = OnRep_Stamina, BlueprintReadOnly, Category = "Stamina")
+    // Exact on the server, decoded from ReplicatedStamina on clients
+    UPROPERTY(BlueprintReadOnly, Category = "Stamina")
     float CurrentStamina;
 
+    UPROPERTY(ReplicatedUsing = OnRep_Stamina)
+    FQuantizedVital ReplicatedStamina;
+
+    // Precision of the replicated stamina over MaxStamina, and how many of those steps it must move before it is sent.
+    // Stamina changes every tick while sprinting or regenerating; 100 steps is what the HUD shows.
+    UPROPERTY(EditDefaultsOnly, Category = "Stamina|Replication", meta = (ClampMin = "1", ClampMax = "1023"))
+    int32 ReplicationSteps = 100;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Stamina|Replication", meta = (ClampMin = "1"))
+    int32 ReplicationThreshold = 1;
+
+    // Seconds after a change held back by the threshold before the exact step is sent anyway
+    UPROPERTY(EditDefaultsOnly, Category = "Stamina|Replication", meta = (ClampMin = "0.01"))
+    float ReplicationSettleDelay = 0.5f;
+
     UPROPERTY(ReplicatedUsing = OnRep_StaminaState, BlueprintReadOnly, Category = "Stamina")
     EStaminaState CurrentStaminaState;
 
@@ -94,6 +115,7 @@ public:
 
     // Internal functions
     void UpdateStaminaState();
+    void SettleReplicatedStamina();
     void HandleStaminaRegeneration(float DeltaTime);
     void HandleStaminaDepletion(float DeltaTime);
     void ApplyExhaustionEffects();
@@ -104,6 +126,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Stamina")
     bool ConsumeStamina(float Amount);
 
+    // Server only
+    UFUNCTION(BlueprintCallable, Category = "Stamina")
+    void RestoreStamina(float Amount);
+
+    // Multiplies the recovery rate for Duration seconds. Server only.
+    UFUNCTION(BlueprintCallable, Category = "Stamina")
+    void ApplyRecoveryBoost(float Multiplier, float Duration);
+
     UFUNCTION(BlueprintCallable, Category = "Stamina")
     void StartSprinting();
 
@@ -135,6 +165,11 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Stamina|Combat")
     bool PerformStruggle();
 
+    // Persistence, see UPlayerSaveSubsystem. Server only.
+    static constexpr uint16 SaveDataVersion = 1;
+    void WriteSaveData(FArchive& Ar) const;
+    bool ReadSaveData(FArchive& Ar, uint16 Version);
+
     // Delegates
     UPROPERTY(BlueprintAssignable, Category = "Stamina")
     FOnStaminaChanged OnStaminaChanged;
@@ -150,7 +185,10 @@ public:
 
 private:
     FTimerHandle ExhaustionRecoveryTimerHandle;
+    FTimerHandle RecoveryBoostTimerHandle;
+    FTimerHandle ReplicationSettleTimerHandle;
     float LastStaminaChangeTime;
+    float RecoveryMultiplier = 1.0f;
 
     UFUNCTION(Server, Reliable)
     void Server_ConsumeStamina(float Amount);
@@ -162,4 +200,5 @@ private:
     void Server_SetRunState(bool bRunning);
 
     void EndExhaustionRecoveryDelay();
+    void EndRecoveryBoost();
 };
\ No newline at end of file
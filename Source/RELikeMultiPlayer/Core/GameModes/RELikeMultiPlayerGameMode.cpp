@@ -2,7 +2,11 @@
 
 #include "RELikeMultiPlayerGameMode.h"
 #include "../../Player/Character/RELikeMultiPlayerCharacter.h"
+#include "../Subsystems/PlayerSaveSubsystem.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerState.h"
 #include "UObject/ConstructorHelpers.h"
+#include "TimerManager.h"
 
 ARELikeMultiPlayerGameMode::ARELikeMultiPlayerGameMode()
 {
@@ -19,4 +23,47 @@ ARELikeMultiPlayerGameMode::ARELikeMultiPlayerGameMode()
 void ARELikeMultiPlayerGameMode::BeginPlay()
 {
 	Super::BeginPlay();
+
+	const UPlayerSaveSubsystem* SaveSubsystem = UPlayerSaveSubsystem::Get(this);
+	if (SaveSubsystem && SaveSubsystem->GetAutosaveInterval() > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(AutosaveTimerHandle, this, &ARELikeMultiPlayerGameMode::Autosave,
+			SaveSubsystem->GetAutosaveInterval(), true);
+	}
+}
+
+void ARELikeMultiPlayerGameMode::SetPlayerDefaults(APawn* PlayerPawn)
+{
+	Super::SetPlayerDefaults(PlayerPawn);
+
+	// Runs on every respawn too, when the save on disk is older than what the player has done since
+	const APlayerState* PlayerState = PlayerPawn ? PlayerPawn->GetPlayerState() : nullptr;
+	if (!PlayerState || !PlayerPawn->HasAuthority()) return;
+
+	bool bAlreadyLoaded = false;
+	LoadedPlayers.Add(PlayerState, &bAlreadyLoaded);
+	if (bAlreadyLoaded) return;
+
+	if (UPlayerSaveSubsystem* SaveSubsystem = UPlayerSaveSubsystem::Get(this))
+	{
+		SaveSubsystem->LoadPlayer(PlayerPawn);
+	}
+}
+
+void ARELikeMultiPlayerGameMode::Logout(AController* Exiting)
+{
+	if (Exiting)
+	{
+		LoadedPlayers.Remove(Exiting->PlayerState.Get());
+	}
+
+	Super::Logout(Exiting);
+}
+
+void ARELikeMultiPlayerGameMode::Autosave()
+{
+	if (UPlayerSaveSubsystem* SaveSubsystem = UPlayerSaveSubsystem::Get(this))
+	{
+		SaveSubsystem->SaveAllPlayers();
+	}
 }
\ No newline at end of file
@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "UObject/ObjectKey.h"
 #include "RELikeMultiPlayerGameMode.generated.h"
 
+class APlayerState;
+
 UCLASS(minimalapi)
 class ARELikeMultiPlayerGameMode : public AGameModeBase
 {
@@ -14,9 +17,21 @@ class ARELikeMultiPlayerGameMode : public AGameModeBase
 public:
 	ARELikeMultiPlayerGameMode();
 
+	// Loads the player's save onto the first pawn they possess
+	virtual void SetPlayerDefaults(APawn* PlayerPawn) override;
+
+	virtual void Logout(AController* Exiting) override;
+
 private:
 
 	virtual void BeginPlay() override;
+
+	void Autosave();
+
+	FTimerHandle AutosaveTimerHandle;
+
+	// Players whose save has been loaded. Respawns keep the player state and start from play, not from disk.
+	TSet<TObjectKey<APlayerState>> LoadedPlayers;
 	
 };
 
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "QuantizedVital.h"
+
+bool FQuantizedVital::Update(float Value, float MaxValue, int32 Steps, int32 Threshold)
+{
+    const int32 GridSteps = FMath::Clamp(Steps, 1, MaxSteps);
+    const float Fraction = MaxValue > 0.0f ? FMath::Clamp(Value / MaxValue, 0.0f, 1.0f) : 0.0f;
+
+    // Anything above zero stays above zero, so clients never see an alive player at 0
+    int32 GridStep = FMath::RoundToInt(Fraction * GridSteps);
+    if (GridStep == 0 && Fraction > 0.0f)
+    {
+        GridStep = 1;
+    }
+    const uint16 NewStep = uint16(FMath::RoundToInt(float(GridStep) * MaxSteps / GridSteps));
+    if (NewStep == Step) return false;
+
+    const bool bEdge = NewStep == 0 || NewStep == MaxSteps || Step == 0;
+    const int32 MovedGridSteps = FMath::Abs(GridStep - FMath::RoundToInt(float(Step) * GridSteps / MaxSteps));
+    if (!bEdge && MovedGridSteps < FMath::Max(Threshold, 1)) return false;
+
+    Step = NewStep;
+    return true;
+}
+
+bool FQuantizedVital::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    uint32 Value = Step;
+    Ar.SerializeInt(Value, MaxSteps + 1);
+    if (Ar.IsLoading())
+    {
+        Step = uint16(FMath::Min<uint32>(Value, MaxSteps));
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
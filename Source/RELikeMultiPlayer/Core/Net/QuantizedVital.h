@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "QuantizedVital.generated.h"
+
+/**
+ * Health, stamina and similar vitals as a fraction of their maximum, sent as a 10-bit step.
+ * The server keeps the exact float; clients only see the step, and only once it has moved far enough.
+ */
+USTRUCT()
+struct RELIKEMULTIPLAYER_API FQuantizedVital
+{
+    GENERATED_BODY()
+
+    // Finest precision the wire format carries
+    static constexpr int32 MaxSteps = 1023;
+
+    // 0 is empty, MaxSteps is full
+    UPROPERTY()
+    uint16 Step = MaxSteps;
+
+    float ToValue(float MaxValue) const { return MaxValue * Step / MaxSteps; }
+
+    // Requantizes Value onto a grid of Steps (at most MaxSteps). The step is kept while it moves less than
+    // Threshold grid steps, except that empty, full and leaving empty always go through.
+    // Returns whether the step changed, i.e. whether the property will be sent.
+    // With Threshold above 1 a small change can be held back for good once the value stops moving,
+    // so owners settle it with a Threshold of 1 after a short idle.
+    bool Update(float Value, float MaxValue, int32 Steps, int32 Threshold);
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FQuantizedVital> : public TStructOpsTypeTraitsBase2<FQuantizedVital>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
@@ -0,0 +1,297 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PlayerSaveSubsystem.h"
+#include "../../Components/Inventory/InventoryComponent.h"
+#include "../../Components/Health/HealthComponent.h"
+#include "../../Components/Stamina/StaminaComponent.h"
+#include "Async/Async.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    struct FSaveSectionHeader
+    {
+        uint16 SectionId = 0;
+        uint16 SectionVersion = 0;
+        uint32 Size = 0;
+        uint32 Crc = 0;
+
+        friend FArchive& operator<<(FArchive& Ar, FSaveSectionHeader& Header)
+        {
+            return Ar << Header.SectionId << Header.SectionVersion << Header.Size << Header.Crc;
+        }
+    };
+
+    template<typename WriteFunc>
+    void WriteSection(FArchive& Ar, EPlayerSaveSection SectionId, uint16 SectionVersion, WriteFunc&& Write)
+    {
+        TArray<uint8> Payload;
+        FMemoryWriter PayloadWriter(Payload);
+        Write(PayloadWriter);
+
+        FSaveSectionHeader Header;
+        Header.SectionId = (uint16)SectionId;
+        Header.SectionVersion = SectionVersion;
+        Header.Size = Payload.Num();
+        Header.Crc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+
+        Ar << Header;
+        Ar.Serialize(Payload.GetData(), Payload.Num());
+    }
+}
+
+UPlayerSaveSubsystem* UPlayerSaveSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+    return GameInstance ? GameInstance->GetSubsystem<UPlayerSaveSubsystem>() : nullptr;
+}
+
+void UPlayerSaveSubsystem::Deinitialize()
+{
+    // Pending writes must land before the process can go away
+    Flush();
+
+    Super::Deinitialize();
+}
+
+FString UPlayerSaveSubsystem::GetSavePath(const APawn* Pawn) const
+{
+    const APlayerState* PlayerState = Pawn ? Pawn->GetPlayerState() : nullptr;
+    if (!PlayerState) return FString();
+
+    // Online IDs are stable across sessions; the name is only good enough for local play
+    const FUniqueNetIdRepl& UniqueId = PlayerState->GetUniqueId();
+    const FString PlayerKey = UniqueId.IsValid() ? UniqueId.ToString() : PlayerState->GetPlayerName();
+
+    return FPaths::ProjectSavedDir() / SaveDirectory / FPaths::MakeValidFileName(PlayerKey) + TEXT(".sav");
+}
+
+void UPlayerSaveSubsystem::BuildSaveData(APawn* Pawn, TArray<uint8>& OutData)
+{
+    OutData.Reset();
+    FMemoryWriter Writer(OutData);
+
+    uint32 Magic = SaveMagic;
+    uint16 FormatVersion = SaveFormatVersion;
+    uint16 NumSections = 0;
+    Writer << Magic << FormatVersion << NumSections;
+
+    if (UInventoryComponent* Inventory = Pawn->FindComponentByClass<UInventoryComponent>())
+    {
+        WriteSection(Writer, EPlayerSaveSection::Inventory, UInventoryComponent::SaveDataVersion,
+            [Inventory](FArchive& Ar) { Inventory->WriteSaveData(Ar); });
+        NumSections++;
+    }
+
+    if (UHealthComponent* Health = Pawn->FindComponentByClass<UHealthComponent>())
+    {
+        WriteSection(Writer, EPlayerSaveSection::Health, UHealthComponent::SaveDataVersion,
+            [Health](FArchive& Ar) { Health->WriteSaveData(Ar); });
+        NumSections++;
+    }
+
+    if (UStaminaComponent* Stamina = Pawn->FindComponentByClass<UStaminaComponent>())
+    {
+        WriteSection(Writer, EPlayerSaveSection::Stamina, UStaminaComponent::SaveDataVersion,
+            [Stamina](FArchive& Ar) { Stamina->WriteSaveData(Ar); });
+        NumSections++;
+    }
+
+    // Patch the section count now that it is known
+    Writer.Seek(sizeof(uint32) + sizeof(uint16));
+    Writer << NumSections;
+}
+
+uint32 UPlayerSaveSubsystem::GetSectionCrc(APawn* Pawn, uint16 SectionId)
+{
+    TArray<uint8> Payload;
+    FMemoryWriter Writer(Payload);
+
+    switch ((EPlayerSaveSection)SectionId)
+    {
+    case EPlayerSaveSection::Inventory:
+        if (const UInventoryComponent* Inventory = Pawn->FindComponentByClass<UInventoryComponent>())
+        {
+            Inventory->WriteSaveData(Writer);
+        }
+        break;
+
+    case EPlayerSaveSection::Health:
+        if (const UHealthComponent* Health = Pawn->FindComponentByClass<UHealthComponent>())
+        {
+            Health->WriteSaveData(Writer);
+        }
+        break;
+
+    case EPlayerSaveSection::Stamina:
+        if (const UStaminaComponent* Stamina = Pawn->FindComponentByClass<UStaminaComponent>())
+        {
+            Stamina->WriteSaveData(Writer);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return Payload.Num() > 0 ? FCrc::MemCrc32(Payload.GetData(), Payload.Num()) : 0;
+}
+
+bool UPlayerSaveSubsystem::ApplySection(APawn* Pawn, uint16 SectionId, uint16 SectionVersion, const TArray<uint8>& Payload)
+{
+    FMemoryReader Reader(Payload);
+
+    switch ((EPlayerSaveSection)SectionId)
+    {
+    case EPlayerSaveSection::Inventory:
+        if (UInventoryComponent* Inventory = Pawn->FindComponentByClass<UInventoryComponent>())
+        {
+            return Inventory->ReadSaveData(Reader, SectionVersion);
+        }
+        break;
+
+    case EPlayerSaveSection::Health:
+        if (UHealthComponent* Health = Pawn->FindComponentByClass<UHealthComponent>())
+        {
+            return Health->ReadSaveData(Reader, SectionVersion);
+        }
+        break;
+
+    case EPlayerSaveSection::Stamina:
+        if (UStaminaComponent* Stamina = Pawn->FindComponentByClass<UStaminaComponent>())
+        {
+            return Stamina->ReadSaveData(Reader, SectionVersion);
+        }
+        break;
+
+    default:
+        // Written by a newer build, skip it
+        break;
+    }
+
+    return false;
+}
+
+void UPlayerSaveSubsystem::SavePlayer(APawn* Pawn)
+{
+    if (!Pawn || !Pawn->HasAuthority()) return;
+
+    const FString SavePath = GetSavePath(Pawn);
+    if (SavePath.IsEmpty()) return;
+
+    // Only the snapshot happens here, it is a few hundred bytes of memory writes
+    TArray<uint8> Data;
+    BuildSaveData(Pawn, Data);
+
+    LastIOTask = IOPipe.Launch(TEXT("PlayerSave.Write"), [SavePath, Data = MoveTemp(Data)]()
+    {
+        // Write beside the old save and swap it in, so a crash mid-write keeps the previous one
+        const FString TempPath = SavePath + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(Data, *TempPath) || !IFileManager::Get().Move(*SavePath, *TempPath, true, true))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PlayerSaveSubsystem: Failed to write %s"), *SavePath);
+        }
+    });
+}
+
+void UPlayerSaveSubsystem::LoadPlayer(APawn* Pawn)
+{
+    if (!Pawn || !Pawn->HasAuthority()) return;
+
+    const FString SavePath = GetSavePath(Pawn);
+    if (SavePath.IsEmpty()) return;
+
+    // The components as the load found them; anything different by the time a section arrives was done in play
+    TMap<uint16, uint32> StartCrcs;
+    for (EPlayerSaveSection Section : { EPlayerSaveSection::Inventory, EPlayerSaveSection::Health, EPlayerSaveSection::Stamina })
+    {
+        StartCrcs.Add((uint16)Section, GetSectionCrc(Pawn, (uint16)Section));
+    }
+
+    TWeakObjectPtr<APawn> WeakPawn(Pawn);
+    LastIOTask = IOPipe.Launch(TEXT("PlayerSave.Read"), [SavePath, WeakPawn, StartCrcs = MoveTemp(StartCrcs)]()
+    {
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*SavePath));
+        if (!Reader) return; // First time this player joins
+
+        uint32 Magic = 0;
+        uint16 FormatVersion = 0;
+        uint16 NumSections = 0;
+        *Reader << Magic << FormatVersion << NumSections;
+        if (Reader->IsError() || Magic != SaveMagic || FormatVersion > SaveFormatVersion)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PlayerSaveSubsystem: %s is not a readable save"), *SavePath);
+            return;
+        }
+
+        for (int32 i = 0; i < NumSections; i++)
+        {
+            FSaveSectionHeader Header;
+            *Reader << Header;
+            if (Reader->IsError() || Header.Size > uint64(Reader->TotalSize() - Reader->Tell()))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("PlayerSaveSubsystem: %s is truncated at section %d"), *SavePath, i);
+                return;
+            }
+
+            TArray<uint8> Payload;
+            Payload.SetNumUninitialized(Header.Size);
+            Reader->Serialize(Payload.GetData(), Header.Size);
+
+            // Sizes are known, so a damaged section is skipped and the rest still load
+            if (FCrc::MemCrc32(Payload.GetData(), Payload.Num()) != Header.Crc)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("PlayerSaveSubsystem: Section %d of %s failed its checksum"), Header.SectionId, *SavePath);
+                continue;
+            }
+
+            // Each section is applied as soon as it is validated
+            const uint32 StartCrc = StartCrcs.FindRef(Header.SectionId);
+            AsyncTask(ENamedThreads::GameThread, [WeakPawn, Header, StartCrc, Payload = MoveTemp(Payload)]()
+            {
+                APawn* Pawn = WeakPawn.Get();
+                if (!Pawn) return;
+
+                if (GetSectionCrc(Pawn, Header.SectionId) != StartCrc)
+                {
+                    UE_LOG(LogTemp, Log, TEXT("PlayerSaveSubsystem: Section %d of %s changed in play before it loaded, skipped"),
+                        Header.SectionId, *Pawn->GetName());
+                    return;
+                }
+                ApplySection(Pawn, Header.SectionId, Header.SectionVersion, Payload);
+            });
+        }
+    });
+}
+
+void UPlayerSaveSubsystem::SaveAllPlayers()
+{
+    UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+    if (!World) return;
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PlayerController = It->Get())
+        {
+            SavePlayer(PlayerController->GetPawn());
+        }
+    }
+}
+
+void UPlayerSaveSubsystem::Flush()
+{
+    if (LastIOTask.IsValid())
+    {
+        LastIOTask.Wait();
+    }
+}
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Pipe.h"
+#include "PlayerSaveSubsystem.generated.h"
+
+class APawn;
+
+// Sections of a player save. Values are part of the file format, never renumber them.
+enum class EPlayerSaveSection : uint16
+{
+    Inventory = 1,
+    Health = 2,
+    Stamina = 3
+};
+
+/**
+ * Per-player binary saves, written and read off the game thread.
+ *
+ * File layout (little endian):
+ *   uint32 Magic, uint16 FormatVersion, uint16 NumSections
+ *   per section: uint16 SectionId, uint16 SectionVersion, uint32 Size, uint32 Crc32, Size bytes of payload
+ *
+ * Sections are validated one at a time while streaming the file, so a damaged or unknown
+ * section only leaves that part of the player at its defaults.
+ */
+UCLASS(Config = Game)
+class RELIKEMULTIPLAYER_API UPlayerSaveSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UPlayerSaveSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Deinitialize() override;
+
+    // Snapshots the pawn on the game thread, then writes the file in the background. Server only.
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    void SavePlayer(APawn* Pawn);
+
+    // Reads the pawn's save in the background and applies each valid section on the game thread. Server only.
+    // A section is skipped if its component changed after this call, so the load never overwrites play.
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    void LoadPlayer(APawn* Pawn);
+
+    UFUNCTION(BlueprintCallable, Category = "Save")
+    void SaveAllPlayers();
+
+    // Blocks until every queued read and write has finished
+    void Flush();
+
+    // Seconds between autosaves, 0 disables them
+    float GetAutosaveInterval() const { return AutosaveInterval; }
+
+    static constexpr uint32 SaveMagic = 0x534C4552; // "RELS"
+    static constexpr uint16 SaveFormatVersion = 1;
+
+    // Serializes the pawn's persistent state into the format above
+    static void BuildSaveData(APawn* Pawn, TArray<uint8>& OutData);
+
+    // Checksum of one section as the pawn would save it now, 0 when the pawn has no such component
+    static uint32 GetSectionCrc(APawn* Pawn, uint16 SectionId);
+
+    // Applies one validated section to the pawn's components
+    static bool ApplySection(APawn* Pawn, uint16 SectionId, uint16 SectionVersion, const TArray<uint8>& Payload);
+
+protected:
+    UPROPERTY(Config)
+    float AutosaveInterval = 60.0f;
+
+    UPROPERTY(Config)
+    FString SaveDirectory = TEXT("PlayerSaves");
+
+private:
+    FString GetSavePath(const APawn* Pawn) const;
+
+    // Reads and writes run in order on one pipe, so a load never sees half of a save
+    UE::Tasks::FPipe IOPipe{ TEXT("PlayerSaveIO") };
+    UE::Tasks::FTask LastIOTask;
+};
@@ -0,0 +1,273 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StatusEffectSubsystem.h"
+#include "../../Components/Health/HealthComponent.h"
+#include "../../Components/Stamina/StaminaComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UStatusEffectSubsystem* UStatusEffectSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr;
+}
+
+bool UStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStatusEffectSubsystem::Deinitialize()
+{
+    EffectTargets.Empty();
+    EffectTypes.Empty();
+    HealthRates.Empty();
+    StaminaRates.Empty();
+    RemainingTimes.Empty();
+    TargetActors.Empty();
+    TargetHealth.Empty();
+    TargetStamina.Empty();
+    HealthDeltas.Empty();
+    StaminaDeltas.Empty();
+    TargetEffectCounts.Empty();
+    FreeTargets.Empty();
+    TargetsByActor.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UStatusEffectSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+void UStatusEffectSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (EffectTargets.Num() == 0)
+    {
+        StepAccumulator = 0.0f;
+        return;
+    }
+
+    StepAccumulator += DeltaTime;
+    for (int32 NumSteps = 0; StepAccumulator >= StepInterval && NumSteps < MaxStepsPerFrame; NumSteps++)
+    {
+        StepAccumulator -= StepInterval;
+        Step();
+    }
+    StepAccumulator = FMath::Min(StepAccumulator, StepInterval);
+}
+
+void UStatusEffectSubsystem::GetRates(EStatusEffectType Type, float Magnitude, float& OutHealthRate, float& OutStaminaRate)
+{
+    switch (Type)
+    {
+    case EStatusEffectType::Bleed:
+        OutHealthRate = -Magnitude;
+        OutStaminaRate = 0.0f;
+        break;
+    case EStatusEffectType::Poison:
+        OutHealthRate = -Magnitude;
+        OutStaminaRate = -Magnitude;
+        break;
+    case EStatusEffectType::Regeneration:
+        OutHealthRate = Magnitude;
+        OutStaminaRate = 0.0f;
+        break;
+    default:
+        OutHealthRate = 0.0f;
+        OutStaminaRate = 0.0f;
+        break;
+    }
+}
+
+bool UStatusEffectSubsystem::ApplyEffect(AActor* Target, EStatusEffectType Type, float Magnitude, float Duration)
+{
+    if (!Target || !Target->HasAuthority() || Type >= EStatusEffectType::MAX || Magnitude <= 0 || Duration <= 0) return false;
+
+    const int32 TargetIndex = FindOrAddTarget(Target);
+    if (TargetIndex == INDEX_NONE) return false;
+
+    const int32 ExistingIndex = FindEffect(TargetIndex, Type);
+    if (ExistingIndex != INDEX_NONE)
+    {
+        // Every effect has a health rate, so its size is the magnitude
+        GetRates(Type, FMath::Max(Magnitude, FMath::Abs(HealthRates[ExistingIndex])), HealthRates[ExistingIndex], StaminaRates[ExistingIndex]);
+        RemainingTimes[ExistingIndex] = FMath::Max(RemainingTimes[ExistingIndex], Duration);
+        return true;
+    }
+
+    float HealthRate = 0.0f;
+    float StaminaRate = 0.0f;
+    GetRates(Type, Magnitude, HealthRate, StaminaRate);
+
+    EffectTargets.Add(TargetIndex);
+    EffectTypes.Add(Type);
+    HealthRates.Add(HealthRate);
+    StaminaRates.Add(StaminaRate);
+    RemainingTimes.Add(Duration);
+    TargetEffectCounts[TargetIndex]++;
+    return true;
+}
+
+void UStatusEffectSubsystem::RemoveEffect(AActor* Target, EStatusEffectType Type)
+{
+    const int32* TargetIndex = TargetsByActor.Find(Target);
+    if (!TargetIndex) return;
+
+    const int32 EffectIndex = FindEffect(*TargetIndex, Type);
+    if (EffectIndex != INDEX_NONE)
+    {
+        RemoveEffectAt(EffectIndex);
+    }
+}
+
+void UStatusEffectSubsystem::ClearEffects(AActor* Target)
+{
+    const int32* TargetIndex = TargetsByActor.Find(Target);
+    if (!TargetIndex) return;
+
+    const int32 ClearedTarget = *TargetIndex;
+    for (int32 EffectIndex = EffectTargets.Num() - 1; EffectIndex >= 0; EffectIndex--)
+    {
+        if (EffectTargets[EffectIndex] == ClearedTarget)
+        {
+            RemoveEffectAt(EffectIndex);
+        }
+    }
+}
+
+bool UStatusEffectSubsystem::HasEffect(const AActor* Target, EStatusEffectType Type) const
+{
+    const int32* TargetIndex = TargetsByActor.Find(Target);
+    return TargetIndex && FindEffect(*TargetIndex, Type) != INDEX_NONE;
+}
+
+void UStatusEffectSubsystem::Step()
+{
+    const float DeltaTime = StepInterval;
+
+    // Sum every effect into its actor's deltas. An effect ending mid-step only counts its remaining time.
+    const int32 NumEffects = EffectTargets.Num();
+    for (int32 EffectIndex = 0; EffectIndex < NumEffects; EffectIndex++)
+    {
+        const float ActiveTime = FMath::Min(RemainingTimes[EffectIndex], DeltaTime);
+        const int32 TargetIndex = EffectTargets[EffectIndex];
+        HealthDeltas[TargetIndex] += HealthRates[EffectIndex] * ActiveTime;
+        StaminaDeltas[TargetIndex] += StaminaRates[EffectIndex] * ActiveTime;
+        RemainingTimes[EffectIndex] -= DeltaTime;
+    }
+
+    // One health and one stamina change per actor. Deltas are cleared before the call,
+    // since the components' delegates may apply or remove effects.
+    for (int32 TargetIndex = 0; TargetIndex < TargetActors.Num(); TargetIndex++)
+    {
+        const float HealthDelta = HealthDeltas[TargetIndex];
+        const float StaminaDelta = StaminaDeltas[TargetIndex];
+        HealthDeltas[TargetIndex] = 0.0f;
+        StaminaDeltas[TargetIndex] = 0.0f;
+
+        if (UHealthComponent* Health = TargetHealth[TargetIndex].Get())
+        {
+            if (HealthDelta < 0.0f)
+            {
+                Health->TakeDamage(-HealthDelta);
+            }
+            else if (HealthDelta > 0.0f && !Health->IsDowned())
+            {
+                Health->Heal(HealthDelta);
+            }
+        }
+
+        if (UStaminaComponent* Stamina = TargetStamina[TargetIndex].Get())
+        {
+            if (StaminaDelta < 0.0f)
+            {
+                Stamina->ConsumeStamina(-StaminaDelta);
+            }
+            else if (StaminaDelta > 0.0f)
+            {
+                Stamina->RestoreStamina(StaminaDelta);
+            }
+        }
+    }
+
+    // Drop expired effects, and every effect on actors that are gone or dead
+    for (int32 EffectIndex = EffectTargets.Num() - 1; EffectIndex >= 0; EffectIndex--)
+    {
+        const int32 TargetIndex = EffectTargets[EffectIndex];
+        const UHealthComponent* Health = TargetHealth[TargetIndex].Get();
+        const bool bTargetGone = Health ? !Health->IsAlive() : !TargetStamina[TargetIndex].IsValid();
+        if (RemainingTimes[EffectIndex] <= 0.0f || bTargetGone)
+        {
+            RemoveEffectAt(EffectIndex);
+        }
+    }
+}
+
+int32 UStatusEffectSubsystem::FindEffect(int32 TargetIndex, EStatusEffectType Type) const
+{
+    for (int32 EffectIndex = 0; EffectIndex < EffectTargets.Num(); EffectIndex++)
+    {
+        if (EffectTargets[EffectIndex] == TargetIndex && EffectTypes[EffectIndex] == Type)
+        {
+            return EffectIndex;
+        }
+    }
+    return INDEX_NONE;
+}
+
+int32 UStatusEffectSubsystem::FindOrAddTarget(AActor* Target)
+{
+    if (const int32* ExistingIndex = TargetsByActor.Find(Target))
+    {
+        return *ExistingIndex;
+    }
+
+    UHealthComponent* Health = Target->FindComponentByClass<UHealthComponent>();
+    UStaminaComponent* Stamina = Target->FindComponentByClass<UStaminaComponent>();
+    if (!Health && !Stamina) return INDEX_NONE;
+
+    int32 TargetIndex = INDEX_NONE;
+    if (FreeTargets.Num() > 0)
+    {
+        TargetIndex = FreeTargets.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        TargetIndex = TargetActors.AddDefaulted();
+        TargetHealth.AddDefaulted();
+        TargetStamina.AddDefaulted();
+        HealthDeltas.Add(0.0f);
+        StaminaDeltas.Add(0.0f);
+        TargetEffectCounts.Add(0);
+    }
+
+    TargetActors[TargetIndex] = Target;
+    TargetHealth[TargetIndex] = Health;
+    TargetStamina[TargetIndex] = Stamina;
+    TargetsByActor.Add(Target, TargetIndex);
+    return TargetIndex;
+}
+
+void UStatusEffectSubsystem::RemoveEffectAt(int32 EffectIndex)
+{
+    const int32 TargetIndex = EffectTargets[EffectIndex];
+    EffectTargets.RemoveAtSwap(EffectIndex, EAllowShrinking::No);
+    EffectTypes.RemoveAtSwap(EffectIndex, EAllowShrinking::No);
+    HealthRates.RemoveAtSwap(EffectIndex, EAllowShrinking::No);
+    StaminaRates.RemoveAtSwap(EffectIndex, EAllowShrinking::No);
+    RemainingTimes.RemoveAtSwap(EffectIndex, EAllowShrinking::No);
+
+    // The actor's entry is reused once its last effect is gone
+    if (--TargetEffectCounts[TargetIndex] == 0)
+    {
+        TargetsByActor.Remove(TargetActors[TargetIndex]);
+        TargetActors[TargetIndex] = TObjectKey<AActor>();
+        TargetHealth[TargetIndex] = nullptr;
+        TargetStamina[TargetIndex] = nullptr;
+        FreeTargets.Add(TargetIndex);
+    }
+}
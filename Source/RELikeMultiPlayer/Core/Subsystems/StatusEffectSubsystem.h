@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "StatusEffectSubsystem.generated.h"
+
+class UHealthComponent;
+class UStaminaComponent;
+
+UENUM(BlueprintType)
+enum class EStatusEffectType : uint8
+{
+    Bleed           UMETA(DisplayName = "Bleed"),           // Magnitude HP lost per second
+    Poison          UMETA(DisplayName = "Poison"),          // Magnitude HP and stamina lost per second
+    Regeneration    UMETA(DisplayName = "Regeneration"),    // Magnitude HP restored per second, paused while downed
+    MAX             UMETA(Hidden)
+};
+
+/**
+ * Every active status effect in the world, stored as parallel arrays and advanced together at a fixed rate.
+ * Each step sums the health and stamina change per actor and hands it to UHealthComponent and
+ * UStaminaComponent once, so a room full of bleeding enemies is one loop instead of a timer per actor.
+ * Effects only run on the server.
+ */
+UCLASS(Config = Game)
+class RELIKEMULTIPLAYER_API UStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UStatusEffectSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Applying an effect the actor already has refreshes it: the longer duration and the stronger magnitude win.
+    // Server only. Fails for actors with neither a health nor a stamina component.
+    UFUNCTION(BlueprintCallable, Category = "Status Effects")
+    bool ApplyEffect(AActor* Target, EStatusEffectType Type, float Magnitude, float Duration);
+
+    UFUNCTION(BlueprintCallable, Category = "Status Effects")
+    void RemoveEffect(AActor* Target, EStatusEffectType Type);
+
+    UFUNCTION(BlueprintCallable, Category = "Status Effects")
+    void ClearEffects(AActor* Target);
+
+    UFUNCTION(BlueprintPure, Category = "Status Effects")
+    bool HasEffect(const AActor* Target, EStatusEffectType Type) const;
+
+    int32 GetNumEffects() const { return EffectTargets.Num(); }
+    float GetStepInterval() const { return StepInterval; }
+
+    // Advances every effect by one StepInterval now
+    void Step();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+    UPROPERTY(Config)
+    float StepInterval = 0.25f;
+
+    // Steps run in one frame at most, the rest of a hitch is dropped
+    UPROPERTY(Config)
+    int32 MaxStepsPerFrame = 4;
+
+private:
+    // Active effects, one entry per effect in each array
+    TArray<int32> EffectTargets;
+    TArray<EStatusEffectType> EffectTypes;
+    TArray<float> HealthRates;
+    TArray<float> StaminaRates;
+    TArray<float> RemainingTimes;
+
+    // Affected actors, one entry per actor in each array. Entries of actors with no effects left are reused.
+    TArray<TObjectKey<AActor>> TargetActors;
+    TArray<TWeakObjectPtr<UHealthComponent>> TargetHealth;
+    TArray<TWeakObjectPtr<UStaminaComponent>> TargetStamina;
+    TArray<float> HealthDeltas;
+    TArray<float> StaminaDeltas;
+    TArray<int32> TargetEffectCounts;
+    TArray<int32> FreeTargets;
+    TMap<TObjectKey<AActor>, int32> TargetsByActor;
+
+    float StepAccumulator = 0.0f;
+
+    static void GetRates(EStatusEffectType Type, float Magnitude, float& OutHealthRate, float& OutStaminaRate);
+
+    int32 FindEffect(int32 TargetIndex, EStatusEffectType Type) const;
+    int32 FindOrAddTarget(AActor* Target);
+    void RemoveEffectAt(int32 EffectIndex);
+};
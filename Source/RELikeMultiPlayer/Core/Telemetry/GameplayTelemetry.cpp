@@ -0,0 +1,230 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameplayTelemetry.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+    // Allocating a serial is a lock-free compare and swap, so this is safe from any thread
+    void GetObjectIdentity(const UObject* Object, uint32& OutId, int32& OutSerial)
+    {
+        if (!Object)
+        {
+            OutId = FGameplayTelemetry::NoActor;
+            OutSerial = 0;
+            return;
+        }
+        OutId = Object->GetUniqueID();
+        OutSerial = GUObjectArray.AllocateSerialNumber(int32(OutId));
+    }
+
+    FString MakeDumpPath(const TCHAR* Name)
+    {
+        return FPaths::ProjectSavedDir() / TEXT("Telemetry") / FString(Name) + TEXT(".reltel");
+    }
+
+    FAutoConsoleCommand DumpTelemetryCommand(
+        TEXT("RELike.Telemetry.Dump"),
+        TEXT("Writes the gameplay telemetry ring to Saved/Telemetry, or to the given path. Decode it with -run=TelemetryDecode."),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            const FString Path = Args.Num() > 0 ? Args[0] : MakeDumpPath(*(TEXT("Telemetry-") + FDateTime::Now().ToString()));
+            if (FGameplayTelemetry::Get().DumpToFile(Path, true))
+            {
+                UE_LOG(LogTemp, Log, TEXT("GameplayTelemetry: Dumped to %s"), *Path);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("GameplayTelemetry: Could not write %s"), *Path);
+            }
+        }));
+}
+
+FGameplayTelemetry& FGameplayTelemetry::Get()
+{
+    static FGameplayTelemetry Instance;
+    return Instance;
+}
+
+FGameplayTelemetry::FGameplayTelemetry()
+    : Records(MakeUnique<FTelemetryRecord[]>(Capacity))
+    , Sequences(MakeUnique<std::atomic<uint64>[]>(Capacity))
+    , CrashDumpPath(MakeDumpPath(TEXT("Crash")))
+{
+    FCoreDelegates::OnHandleSystemError.AddStatic(&FGameplayTelemetry::HandleSystemError);
+}
+
+void FGameplayTelemetry::HandleSystemError()
+{
+    const FGameplayTelemetry& Telemetry = Get();
+    Telemetry.DumpToFile(Telemetry.CrashDumpPath, false);
+}
+
+void FGameplayTelemetry::Write(ETelemetryEvent Type, const UObject* Actor, const UObject* Other, float Value, int32 Extra)
+{
+    const uint64 Ticket = NextTicket.fetch_add(1, std::memory_order_relaxed);
+    const int32 Index = int32(Ticket & (Capacity - 1));
+
+    // Odd while writing, so readers skip the slot instead of copying half a record
+    std::atomic<uint64>& Sequence = Sequences[Index];
+    Sequence.store(Ticket * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    FTelemetryRecord& Slot = Records[Index];
+    Slot.Cycles = FPlatformTime::Cycles64();
+    Slot.Frame = uint32(GFrameCounter);
+    GetObjectIdentity(Actor, Slot.ActorId, Slot.ActorSerial);
+    GetObjectIdentity(Other, Slot.OtherId, Slot.OtherSerial);
+    Slot.Value = Value;
+    Slot.Extra = Extra;
+    Slot.Type = Type;
+
+    Sequence.store(Ticket * 2 + 2, std::memory_order_release);
+}
+
+void FGameplayTelemetry::Snapshot(TArray<FTelemetryRecord>& OutRecords) const
+{
+    const uint64 End = NextTicket.load(std::memory_order_acquire);
+    const uint64 Begin = End > uint64(Capacity) ? End - Capacity : 0;
+
+    OutRecords.Reset(int32(End - Begin));
+    for (uint64 Ticket = Begin; Ticket < End; Ticket++)
+    {
+        const int32 Index = int32(Ticket & (Capacity - 1));
+        const uint64 Written = Ticket * 2 + 2;
+        if (Sequences[Index].load(std::memory_order_acquire) != Written) continue;
+
+        const FTelemetryRecord Copy = Records[Index];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (Sequences[Index].load(std::memory_order_relaxed) != Written) continue;
+
+        OutRecords.Add(Copy);
+    }
+}
+
+bool FGameplayTelemetry::DumpToFile(const FString& Path, bool bIncludeActorNames) const
+{
+    TArray<FTelemetryRecord> Events;
+    Snapshot(Events);
+
+    // Unique IDs are object array indices, reused once an object is collected, so a name is only taken
+    // while the index still holds the recorded serial. Only the game thread may look objects up.
+    TMap<uint64, FString> ActorNames;
+    if (bIncludeActorNames && IsInGameThread())
+    {
+        auto AddName = [&ActorNames](uint32 Id, int32 Serial)
+        {
+            const uint64 Key = MakeObjectKey(Id, Serial);
+            if (Id == NoActor || ActorNames.Contains(Key)) return;
+
+            const FUObjectItem* Item = GUObjectArray.IndexToObject(int32(Id));
+            const UObjectBase* Object = Item && Item->GetSerialNumber() == Serial ? Item->GetObject() : nullptr;
+            if (Object)
+            {
+                ActorNames.Add(Key, static_cast<const UObject*>(Object)->GetName());
+            }
+        };
+
+        for (const FTelemetryRecord& Record : Events)
+        {
+            AddName(Record.ActorId, Record.ActorSerial);
+            AddName(Record.OtherId, Record.OtherSerial);
+        }
+    }
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+    if (!Writer) return false;
+
+    WriteDump(*Writer, Events, ActorNames);
+    return Writer->Close();
+}
+
+void FGameplayTelemetry::WriteDump(FArchive& Ar, TConstArrayView<FTelemetryRecord> Events, const TMap<uint64, FString>& ActorNames)
+{
+    uint32 Magic = DumpMagic;
+    uint16 Version = DumpVersion;
+    uint16 RecordSize = sizeof(FTelemetryRecord);
+    double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+    uint32 NumRecords = Events.Num();
+    Ar << Magic << Version << RecordSize << SecondsPerCycle << NumRecords;
+
+    for (FTelemetryRecord Record : Events)
+    {
+        uint8 Type = uint8(Record.Type);
+        Ar << Record.Cycles << Record.Frame << Record.ActorId << Record.OtherId << Record.ActorSerial << Record.OtherSerial
+            << Record.Value << Record.Extra << Type;
+    }
+
+    uint32 NumNames = ActorNames.Num();
+    Ar << NumNames;
+    for (const TPair<uint64, FString>& Name : ActorNames)
+    {
+        uint64 Key = Name.Key;
+        FString ActorName = Name.Value;
+        Ar << Key << ActorName;
+    }
+}
+
+bool FGameplayTelemetry::ReadDump(FArchive& Ar, FTelemetryDump& OutDump)
+{
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    uint16 RecordSize = 0;
+    uint32 NumRecords = 0;
+    Ar << Magic << Version << RecordSize << OutDump.SecondsPerCycle << NumRecords;
+    if (Ar.IsError() || Magic != DumpMagic || Version != DumpVersion || RecordSize != sizeof(FTelemetryRecord)) return false;
+    if (NumRecords > uint32(Ar.TotalSize())) return false;
+
+    OutDump.Records.SetNum(NumRecords);
+    for (FTelemetryRecord& Record : OutDump.Records)
+    {
+        uint8 Type = 0;
+        Ar << Record.Cycles << Record.Frame << Record.ActorId << Record.OtherId << Record.ActorSerial << Record.OtherSerial
+            << Record.Value << Record.Extra << Type;
+        Record.Type = Type < uint8(ETelemetryEvent::MAX) ? ETelemetryEvent(Type) : ETelemetryEvent::MAX;
+    }
+
+    uint32 NumNames = 0;
+    Ar << NumNames;
+    if (Ar.IsError() || NumNames > uint32(Ar.TotalSize())) return false;
+
+    OutDump.ActorNames.Reset();
+    for (uint32 i = 0; i < NumNames; i++)
+    {
+        uint64 Key = 0;
+        FString ActorName;
+        Ar << Key << ActorName;
+        OutDump.ActorNames.Add(Key, MoveTemp(ActorName));
+    }
+    return !Ar.IsError();
+}
+
+const FString* FTelemetryDump::FindActorName(uint32 Id, int32 Serial) const
+{
+    return ActorNames.Find(FGameplayTelemetry::MakeObjectKey(Id, Serial));
+}
+
+const TCHAR* FGameplayTelemetry::GetEventName(ETelemetryEvent Type)
+{
+    static const TCHAR* Names[] =
+    {
+        TEXT("Damage"),
+        TEXT("Heal"),
+        TEXT("Downed"),
+        TEXT("Died"),
+        TEXT("Revived"),
+        TEXT("ItemPickedUp"),
+        TEXT("ItemUsed"),
+        TEXT("Exhausted"),
+        TEXT("HitRejected"),
+    };
+    static_assert(UE_ARRAY_COUNT(Names) == (int32)ETelemetryEvent::MAX, "One name per ETelemetryEvent");
+
+    const int32 Index = (int32)Type;
+    return Index < UE_ARRAY_COUNT(Names) ? Names[Index] : TEXT("Unknown");
+}
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+// Kinds of telemetry events. Values are part of the dump format, never renumber them.
+enum class ETelemetryEvent : uint8
+{
+    Damage = 0,         // Actor lost Value health to Other, Extra hits in the frame
+    Heal = 1,           // Actor gained Value health
+    Downed = 2,
+    Died = 3,
+    Revived = 4,        // Other is the reviver
+    ItemPickedUp = 5,   // Value items of handle Extra added to Actor's inventory
+    ItemUsed = 6,       // Actor used handle Extra, consuming Value
+    Exhausted = 7,
+    HitRejected = 8,    // Actor's reported hit on Other failed validation, Value seconds rewound, Extra an EHitRejectReason
+    MAX
+};
+
+// One event, fixed size and plain data so it can be copied into the ring and onto disk as is
+struct FTelemetryRecord
+{
+    uint64 Cycles = 0;      // FPlatformTime::Cycles64()
+    uint32 Frame = 0;       // Low bits of GFrameCounter
+    uint32 ActorId = 0;     // UObject unique IDs (object array indices), NoActor when there is none
+    uint32 OtherId = 0;
+    int32 ActorSerial = 0;  // Object array serial numbers; indices are reused after GC, serials are not
+    int32 OtherSerial = 0;
+    float Value = 0.0f;
+    int32 Extra = 0;
+    ETelemetryEvent Type = ETelemetryEvent::MAX;
+    uint8 Padding[3] = {};
+};
+static_assert(sizeof(FTelemetryRecord) == 40, "FTelemetryRecord is written to disk, keep it packed");
+
+// A dump read back from disk
+struct FTelemetryDump
+{
+    double SecondsPerCycle = 0.0;
+    TArray<FTelemetryRecord> Records;
+
+    // Names of the recorded objects whose index still held the same serial when the dump was written,
+    // keyed by FGameplayTelemetry::MakeObjectKey. Empty in crash dumps.
+    TMap<uint64, FString> ActorNames;
+
+    const FString* FindActorName(uint32 Id, int32 Serial) const;
+};
+
+/**
+ * Process-wide ring of the most recent gameplay events.
+ *
+ * Record is lock-free and can be called from any thread: it claims a slot with one atomic increment and
+ * copies 40 bytes, with no allocation or string formatting. When the ring is full the oldest events are
+ * overwritten. The ring is dumped with the RELike.Telemetry.Dump console command, and on a crash;
+ * the TelemetryDecode commandlet turns a dump into CSV.
+ */
+class RELIKEMULTIPLAYER_API FGameplayTelemetry
+{
+public:
+    static constexpr int32 Capacity = 1 << 15;
+    static constexpr uint32 NoActor = MAX_uint32;
+
+    static constexpr uint32 DumpMagic = 0x544C4552; // "RELT"
+    static constexpr uint16 DumpVersion = 2;
+
+    static FGameplayTelemetry& Get();
+
+    static void Record(ETelemetryEvent Type, const UObject* Actor, const UObject* Other = nullptr, float Value = 0.0f, int32 Extra = 0)
+    {
+        Get().Write(Type, Actor, Other, Value, Extra);
+    }
+
+    // Copies the events currently in the ring, oldest first. Events being written at the same time are skipped.
+    void Snapshot(TArray<FTelemetryRecord>& OutRecords) const;
+
+    // Writes the ring to Path. Names are resolved on the game thread only.
+    bool DumpToFile(const FString& Path, bool bIncludeActorNames) const;
+
+    static void WriteDump(FArchive& Ar, TConstArrayView<FTelemetryRecord> Events, const TMap<uint64, FString>& ActorNames);
+
+    // Identifies one object for the lifetime of the process, unlike the index alone
+    static uint64 MakeObjectKey(uint32 Id, int32 Serial) { return (uint64(uint32(Serial)) << 32) | Id; }
+    static bool ReadDump(FArchive& Ar, FTelemetryDump& OutDump);
+
+    static const TCHAR* GetEventName(ETelemetryEvent Type);
+
+private:
+    FGameplayTelemetry();
+
+    void Write(ETelemetryEvent Type, const UObject* Actor, const UObject* Other, float Value, int32 Extra);
+
+    static void HandleSystemError();
+
+    // Slot i holds ticket t when Sequences[i] == t * 2 + 2, and is being written while it is odd
+    TUniquePtr<FTelemetryRecord[]> Records;
+    TUniquePtr<std::atomic<uint64>[]> Sequences;
+    std::atomic<uint64> NextTicket{ 0 };
+
+    // Built up front, so a crash does not have to
+    FString CrashDumpPath;
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TelemetryDecodeCommandlet.h"
+#include "GameplayTelemetry.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UTelemetryDecodeCommandlet::UTelemetryDecodeCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UTelemetryDecodeCommandlet::Main(const FString& Params)
+{
+    FString InPath;
+    if (!FParse::Value(*Params, TEXT("In="), InPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryDecode: Usage: -run=TelemetryDecode -In=<dump.reltel> [-Out=<file.csv>]"));
+        return 1;
+    }
+
+    FString OutPath;
+    if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+    {
+        OutPath = FPaths::ChangeExtension(InPath, TEXT("csv"));
+    }
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InPath));
+    FTelemetryDump Dump;
+    if (!Reader || !FGameplayTelemetry::ReadDump(*Reader, Dump))
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryDecode: %s is not a readable telemetry dump"), *InPath);
+        return 1;
+    }
+
+    auto GetActorName = [&Dump](uint32 Id, int32 Serial) -> FString
+    {
+        if (Id == FGameplayTelemetry::NoActor) return FString();
+        const FString* Name = Dump.FindActorName(Id, Serial);
+        return Name ? *Name : FString::Printf(TEXT("#%u.%d"), Id, Serial);
+    };
+
+    // Seconds are relative to the first event in the dump. Events from other threads may be slightly out of order.
+    const uint64 FirstCycles = Dump.Records.Num() > 0 ? Dump.Records[0].Cycles : 0;
+    int32 Counts[(int32)ETelemetryEvent::MAX + 1] = {};
+    double Totals[(int32)ETelemetryEvent::MAX + 1] = {};
+
+    TArray<FString> Lines;
+    Lines.Reserve(Dump.Records.Num() + 1);
+    Lines.Add(TEXT("Seconds,Frame,Event,Actor,Other,Value,Extra"));
+    for (const FTelemetryRecord& Record : Dump.Records)
+    {
+        const double Seconds = double(int64(Record.Cycles - FirstCycles)) * Dump.SecondsPerCycle;
+        Lines.Add(FString::Printf(TEXT("%.6f,%u,%s,%s,%s,%g,%d"), Seconds, Record.Frame, FGameplayTelemetry::GetEventName(Record.Type),
+            *GetActorName(Record.ActorId, Record.ActorSerial), *GetActorName(Record.OtherId, Record.OtherSerial), Record.Value, Record.Extra));
+
+        Counts[(int32)Record.Type]++;
+        Totals[(int32)Record.Type] += Record.Value;
+    }
+
+    if (!FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryDecode: Could not write %s"), *OutPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("TelemetryDecode: %d events written to %s"), Dump.Records.Num(), *OutPath);
+    for (int32 Type = 0; Type <= (int32)ETelemetryEvent::MAX; Type++)
+    {
+        if (Counts[Type] > 0)
+        {
+            UE_LOG(LogTemp, Display, TEXT("  %-14s %8d events, value total %.1f"), FGameplayTelemetry::GetEventName(ETelemetryEvent(Type)), Counts[Type], Totals[Type]);
+        }
+    }
+    return 0;
+}
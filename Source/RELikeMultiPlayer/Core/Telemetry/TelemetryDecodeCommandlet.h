@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TelemetryDecodeCommandlet.generated.h"
+
+/**
+ * Turns a gameplay telemetry dump into CSV and logs per-event totals.
+ *
+ *   UnrealEditor-Cmd RELikeMultiPlayer -run=TelemetryDecode -In=<dump.reltel> [-Out=<file.csv>]
+ *
+ * Without -Out the CSV is written next to the dump.
+ */
+UCLASS()
+class UTelemetryDecodeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTelemetryDecodeCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "ItemData.generated.h"
+
+class UTexture2D;
+class AItemPickup;
+
+// Item Categories
+UENUM(BlueprintType)
+enum class EItemCategory : uint8
+{
+    None         UMETA(DisplayName = "None"),
+    Medical      UMETA(DisplayName = "Medical"),
+    Tools        UMETA(DisplayName = "Tools"),
+    Weapons      UMETA(DisplayName = "Weapons"),
+    Resources    UMETA(DisplayName = "Resources"),
+    Lore         UMETA(DisplayName = "Lore")
+};
+
+// What using an item does. Indexes the inventory's effect handler table.
+UENUM(BlueprintType)
+enum class EItemEffectType : uint8
+{
+    None                    UMETA(DisplayName = "None"),
+    Heal                    UMETA(DisplayName = "Heal"),
+    RestoreStamina          UMETA(DisplayName = "Restore Stamina"),
+    StaminaRecoveryBoost    UMETA(DisplayName = "Stamina Recovery Boost"),
+    Regeneration            UMETA(DisplayName = "Regeneration"),
+    MAX                     UMETA(Hidden)
+};
+
+// Combining this item with OtherItemID produces ResultItemID. A+B and B+A are the same recipe.
+USTRUCT(BlueprintType)
+struct FItemCombineRecipe
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combine")
+    FName OtherItemID;
+
+    // Consumed from this item's stack
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combine", meta = (ClampMin = "1"))
+    int32 Quantity = 1;
+
+    // Consumed from the other item's stack
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combine", meta = (ClampMin = "1"))
+    int32 OtherQuantity = 1;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combine")
+    FName ResultItemID;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combine", meta = (ClampMin = "1"))
+    int32 ResultQuantity = 1;
+};
+
+// Item Data Structure
+USTRUCT(BlueprintType)
+struct FItemData : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    FString ItemID;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    FString ItemName;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    FString Description;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    EItemCategory Category;
+
+    // Soft so loading DT_Items does not pull in every icon. Streamed on demand, never on dedicated servers.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (AssetBundles = "UI"))
+    TSoftObjectPtr<UTexture2D> Icon;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    bool bStackable = false;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    int32 MaxStackSize = 1;
+
+    // Preloaded once the item is in an inventory
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (AssetBundles = "Game"))
+    TSoftClassPtr<AItemPickup> PickupClass;
+
+    // Shown to other players through the inventory summary
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+    bool bIsKeyItem = false;
+
+    // Cells taken in grid inventories
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid", meta = (ClampMin = "1"))
+    int32 GridWidth = 1;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Grid", meta = (ClampMin = "1"))
+    int32 GridHeight = 1;
+
+    // Use effect. Medical rows left at None heal by their legacy amount.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Use")
+    EItemEffectType EffectType = EItemEffectType::None;
+
+    // Health or stamina restored, the recovery rate multiplier for boosts, or health per second for regeneration
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Use")
+    float EffectMagnitude = 0.0f;
+
+    // Seconds a boost or regeneration lasts
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Use")
+    float EffectDuration = 0.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Use")
+    bool bConsumeOnUse = true;
+
+    // Each recipe only needs to be authored on one of its two ingredients
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combine")
+    TArray<FItemCombineRecipe> CombineRecipes;
+
+    FItemData()
+    {
+        ItemID = "";
+        ItemName = "Unknown Item";
+        Description = "";
+        Category = EItemCategory::None;
+        bStackable = false;
+        MaxStackSize = 1;
+    }
+};
+
+// Compact index into the item registry. Stable for the lifetime of the game instance.
+USTRUCT(BlueprintType)
+struct FItemHandle
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    int32 Index = INDEX_NONE;
+
+    FItemHandle() = default;
+    explicit FItemHandle(int32 InIndex) : Index(InIndex) {}
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+
+    bool operator==(const FItemHandle& Other) const { return Index == Other.Index; }
+    bool operator!=(const FItemHandle& Other) const { return Index != Other.Index; }
+
+    friend uint32 GetTypeHash(const FItemHandle& Handle) { return ::GetTypeHash(Handle.Index); }
+};
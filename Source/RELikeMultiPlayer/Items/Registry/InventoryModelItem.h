@@ -0,0 +1,16 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Stacking and footprint rules of one item, indexed like the item registry.
+// Compiled by the registry and read by FInventoryModel, so it depends on Core only.
+struct FInventoryModelItem
+{
+    bool bStackable = false;
+    int32 MaxStackSize = 1;
+
+    // Unrotated footprint in grid layout
+    FIntPoint GridSize = FIntPoint(1, 1);
+};
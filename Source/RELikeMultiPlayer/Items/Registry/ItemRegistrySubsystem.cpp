@@ -0,0 +1,307 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ItemRegistrySubsystem.h"
+#include "../Base/ItemPickup.h"
+#include "Engine/AssetManager.h"
+#include "Engine/DataTable.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+
+void UItemRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (!ItemDataTable.IsNull())
+    {
+        BuildFromDataTable(ItemDataTable.LoadSynchronous());
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ItemRegistrySubsystem: No ItemDataTable configured, waiting for a component to provide one"));
+    }
+}
+
+void UItemRegistrySubsystem::Deinitialize()
+{
+    Definitions.Empty();
+    DisplayInfos.Empty();
+    ModelItems.Empty();
+    IndexByItemID.Empty();
+    RecipesByPair.Empty();
+    ItemsByCategory.Empty();
+    ItemsByID.Empty();
+    KeyItems.Empty();
+    ReleaseIcons();
+    PickupClassHandles.Empty();
+    PickupPreloadRequested.Empty();
+    bIsBuilt = false;
+
+    Super::Deinitialize();
+}
+
+UItemRegistrySubsystem* UItemRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+    const UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+    return GameInstance ? GameInstance->GetSubsystem<UItemRegistrySubsystem>() : nullptr;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+void UItemRegistrySubsystem::RebuildForTesting(const UDataTable* Table)
+{
+    Definitions.Reset();
+    DisplayInfos.Reset();
+    ModelItems.Reset();
+    IndexByItemID.Reset();
+    RecipesByPair.Reset();
+    ItemsByCategory.Reset();
+    ItemsByID.Reset();
+    KeyItems.Reset();
+    ReleaseIcons();
+    PickupClassHandles.Reset();
+    bIsBuilt = false;
+
+    BuildFromDataTable(Table);
+}
+#endif
+
+void UItemRegistrySubsystem::BuildFromDataTable(const UDataTable* Table)
+{
+    if (bIsBuilt || !Table) return;
+
+    // UI-only fields are never read on a dedicated server
+    const bool bCompileDisplayInfo = !IsRunningDedicatedServer();
+
+    const TMap<FName, uint8*>& RowMap = Table->GetRowMap();
+    Definitions.Reserve(RowMap.Num());
+    ModelItems.Reserve(RowMap.Num());
+    IndexByItemID.Reserve(RowMap.Num());
+    if (bCompileDisplayInfo)
+    {
+        DisplayInfos.Reserve(RowMap.Num());
+    }
+
+    // Rows are compiled in table order, so handles match between server and clients
+    static const FString ContextString(TEXT("Item Registry Build"));
+    for (const TPair<FName, uint8*>& Row : RowMap)
+    {
+        const FItemData* ItemData = Table->FindRow<FItemData>(Row.Key, ContextString);
+        if (!ItemData) continue;
+
+        const int32 Index = Definitions.AddDefaulted();
+        FItemDefinition& Definition = Definitions[Index];
+        Definition.ItemID = Row.Key.ToString();
+        Definition.Category = ItemData->Category;
+        Definition.bStackable = ItemData->bStackable;
+        Definition.MaxStackSize = ItemData->bStackable ? FMath::Max(1, ItemData->MaxStackSize) : 1;
+        Definition.PickupClass = ItemData->PickupClass;
+        Definition.bIsKeyItem = ItemData->bIsKeyItem;
+        Definition.GridSize = FIntPoint(FMath::Max(1, ItemData->GridWidth), FMath::Max(1, ItemData->GridHeight));
+        CompileUseEffect(*ItemData, Definition);
+
+        FInventoryModelItem& ModelItem = ModelItems.AddDefaulted_GetRef();
+        ModelItem.bStackable = Definition.bStackable;
+        ModelItem.MaxStackSize = Definition.MaxStackSize;
+        ModelItem.GridSize = Definition.GridSize;
+
+        if (bCompileDisplayInfo)
+        {
+            FItemDisplayInfo& DisplayInfo = DisplayInfos.AddDefaulted_GetRef();
+            DisplayInfo.ItemName = ItemData->ItemName;
+            DisplayInfo.Description = ItemData->Description;
+            DisplayInfo.Icon = ItemData->Icon;
+        }
+
+        IndexByItemID.Add(Row.Key, Index);
+        if (Definition.bIsKeyItem)
+        {
+            KeyItems.Add(FItemHandle(Index));
+        }
+    }
+
+    // Recipes reference other rows, so they are resolved once every handle exists
+    CompileCombineRecipes(Table);
+    CompileSortOrders();
+    PickupPreloadRequested.Init(false, Definitions.Num());
+
+    bIsBuilt = true;
+
+    UE_LOG(LogTemp, Log, TEXT("ItemRegistrySubsystem: Compiled %d items and %d recipes from %s (display info: %s)"),
+        Definitions.Num(), RecipesByPair.Num(), *Table->GetName(), bCompileDisplayInfo ? TEXT("Yes") : TEXT("No"));
+}
+
+void UItemRegistrySubsystem::CompileCombineRecipes(const UDataTable* Table)
+{
+    static const FString ContextString(TEXT("Item Registry Recipes"));
+    for (const TPair<FName, uint8*>& Row : Table->GetRowMap())
+    {
+        const FItemData* ItemData = Table->FindRow<FItemData>(Row.Key, ContextString);
+        if (!ItemData) continue;
+
+        const FItemHandle Self = FindItem(Row.Key);
+        for (const FItemCombineRecipe& Source : ItemData->CombineRecipes)
+        {
+            const FItemHandle Other = FindItem(Source.OtherItemID);
+            const FItemHandle Result = FindItem(Source.ResultItemID);
+            if (!Other.IsValid() || !Result.IsValid())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ItemRegistrySubsystem: Recipe %s + %s references an unknown item, skipped"),
+                    *Row.Key.ToString(), *Source.OtherItemID.ToString());
+                continue;
+            }
+
+            const uint64 Key = MakeRecipeKey(Self, Other);
+            if (RecipesByPair.Contains(Key))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ItemRegistrySubsystem: Duplicate recipe %s + %s, keeping the first"),
+                    *Row.Key.ToString(), *Source.OtherItemID.ToString());
+                continue;
+            }
+
+            const bool bSelfFirst = Self.Index <= Other.Index;
+            FCombineRecipe& Recipe = RecipesByPair.Add(Key);
+            Recipe.IngredientA = bSelfFirst ? Self : Other;
+            Recipe.QuantityA = FMath::Max(1, bSelfFirst ? Source.Quantity : Source.OtherQuantity);
+            Recipe.IngredientB = bSelfFirst ? Other : Self;
+            Recipe.QuantityB = FMath::Max(1, bSelfFirst ? Source.OtherQuantity : Source.Quantity);
+            Recipe.Result = Result;
+            Recipe.ResultQuantity = FMath::Max(1, Source.ResultQuantity);
+        }
+    }
+}
+
+void UItemRegistrySubsystem::CompileUseEffect(const FItemData& ItemData, FItemDefinition& Definition)
+{
+    Definition.EffectType = ItemData.EffectType;
+    Definition.EffectMagnitude = ItemData.EffectMagnitude;
+    Definition.EffectDuration = ItemData.EffectDuration;
+    Definition.bConsumeOnUse = ItemData.bConsumeOnUse;
+    Definition.bUsable = ItemData.EffectType != EItemEffectType::None && ItemData.EffectType != EItemEffectType::MAX;
+
+    if (Definition.bUsable) return;
+
+    // Rows authored before effects lived in the table keep their old behaviour
+    Definition.EffectType = EItemEffectType::None;
+    switch (ItemData.Category)
+    {
+    case EItemCategory::Medical:
+        Definition.bUsable = true;
+        Definition.bConsumeOnUse = true;
+        Definition.EffectType = EItemEffectType::Heal;
+        Definition.EffectMagnitude = Definition.ItemID == TEXT("medkit") ? 50.0f
+            : Definition.ItemID == TEXT("painpills") ? 15.0f
+            : 25.0f;
+        break;
+
+    case EItemCategory::Tools:
+        // Tools are used but not consumed
+        Definition.bUsable = true;
+        Definition.bConsumeOnUse = false;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void UItemRegistrySubsystem::CompileSortOrders()
+{
+    ItemsByID.Reset(Definitions.Num());
+    for (int32 Index = 0; Index < Definitions.Num(); Index++)
+    {
+        ItemsByID.Add(FItemHandle(Index));
+    }
+    ItemsByID.Sort([this](FItemHandle A, FItemHandle B)
+    {
+        return Definitions[A.Index].ItemID < Definitions[B.Index].ItemID;
+    });
+
+    ItemsByCategory = ItemsByID;
+    ItemsByCategory.StableSort([this](FItemHandle A, FItemHandle B)
+    {
+        return Definitions[A.Index].Category < Definitions[B.Index].Category;
+    });
+
+    for (int32 Rank = 0; Rank < Definitions.Num(); Rank++)
+    {
+        Definitions[ItemsByID[Rank].Index].IDSortRank = Rank;
+        Definitions[ItemsByCategory[Rank].Index].CategorySortRank = Rank;
+    }
+}
+
+FItemHandle UItemRegistrySubsystem::FindItem(const FString& ItemID) const
+{
+    if (ItemID.IsEmpty()) return FItemHandle();
+
+    // FNAME_Find never grows the global name table for unknown IDs
+    return FindItem(FName(*ItemID, FNAME_Find));
+}
+
+FItemHandle UItemRegistrySubsystem::FindItem(FName ItemID) const
+{
+    const int32* Index = IndexByItemID.Find(ItemID);
+    return Index ? FItemHandle(*Index) : FItemHandle();
+}
+
+void UItemRegistrySubsystem::RequestIcons()
+{
+    // Display info, and with it every icon path, is not compiled on dedicated servers
+    if (IconLoadHandle.IsValid() || DisplayInfos.Num() == 0 || !UAssetManager::IsInitialized()) return;
+
+    TArray<FSoftObjectPath> IconPaths;
+    IconPaths.Reserve(DisplayInfos.Num());
+    for (const FItemDisplayInfo& DisplayInfo : DisplayInfos)
+    {
+        if (!DisplayInfo.Icon.IsNull())
+        {
+            IconPaths.Add(DisplayInfo.Icon.ToSoftObjectPath());
+        }
+    }
+    if (IconPaths.Num() == 0) return;
+
+    IconLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(IconPaths),
+        FStreamableDelegate::CreateUObject(this, &UItemRegistrySubsystem::HandleIconsLoaded));
+}
+
+void UItemRegistrySubsystem::ReleaseIcons()
+{
+    if (IconLoadHandle.IsValid())
+    {
+        IconLoadHandle->ReleaseHandle();
+        IconLoadHandle.Reset();
+    }
+}
+
+bool UItemRegistrySubsystem::AreIconsLoaded() const
+{
+    return IconLoadHandle.IsValid() && IconLoadHandle->HasLoadCompleted();
+}
+
+void UItemRegistrySubsystem::HandleIconsLoaded()
+{
+    OnIconsLoaded.Broadcast();
+}
+
+void UItemRegistrySubsystem::RequestPickupClassLoad(FItemHandle Handle)
+{
+    PickupPreloadRequested[Handle.Index] = true;
+
+    const TSoftClassPtr<AItemPickup>& PickupClass = Definitions[Handle.Index].PickupClass;
+    if (PickupClass.IsNull() || !UAssetManager::IsInitialized()) return;
+
+    // The handle keeps the class resident for the rest of the session
+    TSharedPtr<FStreamableHandle> LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(PickupClass.ToSoftObjectPath());
+    if (LoadHandle.IsValid())
+    {
+        PickupClassHandles.Add(MoveTemp(LoadHandle));
+    }
+}
+
+bool UItemRegistrySubsystem::GetItemDisplayInfo(const FString& ItemID, FItemDisplayInfo& OutDisplayInfo) const
+{
+    const FItemDisplayInfo* DisplayInfo = GetDisplayInfo(FindItem(ItemID));
+    if (!DisplayInfo) return false;
+
+    OutDisplayInfo = *DisplayInfo;
+    return true;
+}
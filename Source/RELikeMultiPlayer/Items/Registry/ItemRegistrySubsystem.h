@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "../Data/ItemData.h"
+#include "InventoryModelItem.h"
+#include "ItemRegistrySubsystem.generated.h"
+
+class UDataTable;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnItemIconsLoaded);
+
+// Gameplay fields of an item, compiled once from FItemData
+USTRUCT()
+struct FItemDefinition
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString ItemID;
+
+    UPROPERTY()
+    EItemCategory Category = EItemCategory::None;
+
+    UPROPERTY()
+    bool bStackable = false;
+
+    UPROPERTY()
+    int32 MaxStackSize = 1;
+
+    UPROPERTY()
+    TSoftClassPtr<AItemPickup> PickupClass;
+
+    // Position in GetItemsByCategory() and GetItemsByID()
+    UPROPERTY()
+    int32 CategorySortRank = 0;
+
+    UPROPERTY()
+    int32 IDSortRank = 0;
+
+    UPROPERTY()
+    bool bIsKeyItem = false;
+
+    // Unrotated footprint in grid inventories
+    UPROPERTY()
+    FIntPoint GridSize = FIntPoint(1, 1);
+
+    // Use effect, resolved once so UseItem is a table lookup
+    UPROPERTY()
+    bool bUsable = false;
+
+    UPROPERTY()
+    bool bConsumeOnUse = false;
+
+    UPROPERTY()
+    EItemEffectType EffectType = EItemEffectType::None;
+
+    UPROPERTY()
+    float EffectMagnitude = 0.0f;
+
+    UPROPERTY()
+    float EffectDuration = 0.0f;
+};
+
+// Compiled combine recipe. Ingredients are stored in handle order, matching the lookup key.
+struct FCombineRecipe
+{
+    FItemHandle IngredientA;
+    int32 QuantityA = 1;
+    FItemHandle IngredientB;
+    int32 QuantityB = 1;
+    FItemHandle Result;
+    int32 ResultQuantity = 1;
+};
+
+// Presentation fields of an item. Not compiled on dedicated servers.
+USTRUCT(BlueprintType)
+struct FItemDisplayInfo
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    FString ItemName;
+
+    UPROPERTY(BlueprintReadOnly)
+    FString Description;
+
+    // Soft reference, always set when the row has an icon. Get() returns the texture once RequestIcons has streamed it in, null before.
+    UPROPERTY(BlueprintReadOnly)
+    TSoftObjectPtr<UTexture2D> Icon;
+};
+
+/**
+ * Flat, immutable item registry built from DT_Items when the game instance starts.
+ * Items are addressed by FItemHandle, so gameplay code never hashes strings or searches the DataTable.
+ */
+UCLASS(Config = Game)
+class RELIKEMULTIPLAYER_API UItemRegistrySubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    static UItemRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+    // Compiles Table into the registry. Ignored once the registry has been built.
+    void BuildFromDataTable(const UDataTable* Table);
+
+#if WITH_DEV_AUTOMATION_TESTS
+    // Drops the current contents and compiles Table instead
+    void RebuildForTesting(const UDataTable* Table);
+#endif
+
+    bool IsBuilt() const { return bIsBuilt; }
+    int32 GetNumItems() const { return Definitions.Num(); }
+
+    // Resolves an item ID to its handle. Does not add unknown IDs to the name table.
+    FItemHandle FindItem(const FString& ItemID) const;
+    FItemHandle FindItem(FName ItemID) const;
+
+    const FItemDefinition* GetDefinition(FItemHandle Handle) const
+    {
+        return Definitions.IsValidIndex(Handle.Index) ? &Definitions[Handle.Index] : nullptr;
+    }
+
+    const FItemDisplayInfo* GetDisplayInfo(FItemHandle Handle) const
+    {
+        return DisplayInfos.IsValidIndex(Handle.Index) ? &DisplayInfos[Handle.Index] : nullptr;
+    }
+
+    // Every item ordered by category then ID, and by ID alone
+    const TArray<FItemHandle>& GetItemsByCategory() const { return ItemsByCategory; }
+    const TArray<FItemHandle>& GetItemsByID() const { return ItemsByID; }
+
+    // Items flagged bIsKeyItem
+    const TArray<FItemHandle>& GetKeyItems() const { return KeyItems; }
+
+    // Stacking and footprint rules by handle index, shared by every FInventoryModel
+    TConstArrayView<FInventoryModelItem> GetModelItems() const { return ModelItems; }
+
+    // Recipe combining A and B, in either order
+    const FCombineRecipe* FindCombineRecipe(FItemHandle A, FItemHandle B) const
+    {
+        return (A.IsValid() && B.IsValid()) ? RecipesByPair.Find(MakeRecipeKey(A, B)) : nullptr;
+    }
+
+    UFUNCTION(BlueprintCallable, Category = "Items")
+    bool GetItemDisplayInfo(const FString& ItemID, FItemDisplayInfo& OutDisplayInfo) const;
+
+    // Streams every item icon in the background, e.g. when the inventory UI opens. OnIconsLoaded fires when done.
+    UFUNCTION(BlueprintCallable, Category = "Items")
+    void RequestIcons();
+
+    // Lets the icons be garbage collected again, e.g. when the inventory UI closes
+    UFUNCTION(BlueprintCallable, Category = "Items")
+    void ReleaseIcons();
+
+    UFUNCTION(BlueprintPure, Category = "Items")
+    bool AreIconsLoaded() const;
+
+    UPROPERTY(BlueprintAssignable, Category = "Items")
+    FOnItemIconsLoaded OnIconsLoaded;
+
+    // Starts loading the item's pickup class the first time it is seen in an inventory, and keeps it resident
+    void PreloadPickupClass(FItemHandle Handle)
+    {
+        if (PickupPreloadRequested.IsValidIndex(Handle.Index) && !PickupPreloadRequested[Handle.Index])
+        {
+            RequestPickupClassLoad(Handle);
+        }
+    }
+
+protected:
+    // Table compiled at startup, set in DefaultGame.ini
+    UPROPERTY(Config)
+    TSoftObjectPtr<UDataTable> ItemDataTable;
+
+    UPROPERTY()
+    TArray<FItemDefinition> Definitions;
+
+    UPROPERTY()
+    TArray<FItemDisplayInfo> DisplayInfos;
+
+    TMap<FName, int32> IndexByItemID;
+
+    TArray<FInventoryModelItem> ModelItems;
+
+    TArray<FItemHandle> ItemsByCategory;
+    TArray<FItemHandle> ItemsByID;
+    TArray<FItemHandle> KeyItems;
+
+    TSharedPtr<FStreamableHandle> IconLoadHandle;
+    TArray<TSharedPtr<FStreamableHandle>> PickupClassHandles;
+    TBitArray<> PickupPreloadRequested;
+
+    void RequestPickupClassLoad(FItemHandle Handle);
+    void HandleIconsLoaded();
+
+    // Keyed by the unordered ingredient pair
+    TMap<uint64, FCombineRecipe> RecipesByPair;
+
+    bool bIsBuilt = false;
+
+    static void CompileUseEffect(const FItemData& ItemData, FItemDefinition& Definition);
+    void CompileCombineRecipes(const UDataTable* Table);
+    void CompileSortOrders();
+
+    static uint64 MakeRecipeKey(FItemHandle A, FItemHandle B)
+    {
+        const uint32 Low = (uint32)FMath::Min(A.Index, B.Index);
+        const uint32 High = (uint32)FMath::Max(A.Index, B.Index);
+        return ((uint64)Low << 32) | High;
+    }
+};
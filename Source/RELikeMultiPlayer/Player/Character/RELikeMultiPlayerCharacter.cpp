@@ -14,11 +14,13 @@
 #include "../../Components/Inventory/InventoryComponent.h"
 #include "../../Components/Health/HealthComponent.h"
 #include "../../Components/Stamina/StaminaComponent.h"
+#include "../../Components/Combat/LagCompensationComponent.h"
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
 #include "Components/Widget.h"
 #include "Net/UnrealNetwork.h"
 #include "../../UI/HUD/PlayerHUDWidget.h"
+#include "../../Core/Subsystems/PlayerSaveSubsystem.h"
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -108,6 +110,9 @@ ARELikeMultiPlayerCharacter::ARELikeMultiPlayerCharacter() //:
 		UE_LOG(LogTemp, Error, TEXT("Failed to create StaminaComponent in constructor"));
 	}
 
+	// Records the capsule on the server for hit validation
+	LagCompensationComponent = CreateDefaultSubobject<ULagCompensationComponent>(TEXT("LagCompensationComponent"));
+
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
 
@@ -252,6 +257,20 @@ void ARELikeMultiPlayerCharacter::Tick(float DeltaTime)
     Super::Tick(DeltaTime);
 }
 
+void ARELikeMultiPlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The player state is still attached here when a player disconnects
+	if (HasAuthority() && GetPlayerState())
+	{
+		if (UPlayerSaveSubsystem* SaveSubsystem = UPlayerSaveSubsystem::Get(this))
+		{
+			SaveSubsystem->SavePlayer(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ARELikeMultiPlayerCharacter::HidePlayer()
 {
 	// Hide the player
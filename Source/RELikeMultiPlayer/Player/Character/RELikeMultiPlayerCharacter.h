@@ -36,6 +36,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	class UStaminaComponent* StaminaComponent;
 
+	/** Lag Compensation Component */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	class ULagCompensationComponent* LagCompensationComponent;
+
 	/** Base turn rate, in deg/sec. Other scaling may affect final turn rate. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Input, meta = (AllowPrivateAccess = "true"))
 	float TurnRateGamepad;
@@ -117,6 +121,9 @@ protected:
 
 	// To add mapping context
 	virtual void BeginPlay() override;
+
+	// Saves the player's state when the character leaves the game
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	// Component lifecycle tracking
 	virtual void PostInitializeComponents() override;
@@ -172,5 +179,8 @@ public:
 
 	/** Returns StaminaComponent subobject **/
 	FORCEINLINE class UStaminaComponent* GetStaminaComponent() const { return StaminaComponent; }
+
+	/** Returns LagCompensationComponent subobject **/
+	FORCEINLINE class ULagCompensationComponent* GetLagCompensationComponent() const { return LagCompensationComponent; }
 };
 
@@ -8,7 +8,7 @@ public class RELikeMultiPlayer : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "EnhancedInput", "OnlineSubsystemSteam", "OnlineSubsystem", "UMG", "Slate", "SlateCore" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "NetCore", "InputCore", "HeadMountedDisplay", "EnhancedInput", "OnlineSubsystemSteam", "OnlineSubsystem", "UMG", "Slate", "SlateCore" });
 
 		PublicIncludePaths.AddRange(new string[] { "RELikeMultiPlayer/Core", "RELikeMultiPlayer/Player", "RELikeMultiPlayer/Components", "RELikeMultiPlayer/Items","RELikeMultiPlayer/AI", "RELikeMultiPlayer/UI"});
 	}
@@ -0,0 +1,286 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameplayTestEnvironment.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "../Components/Inventory/InventoryComponent.h"
+#include "../Components/Inventory/InventoryModel.h"
+#include "../Components/Health/HealthComponent.h"
+#include "../Components/Stamina/StaminaComponent.h"
+#include "../Components/Combat/LagCompensationComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "../Core/Subsystems/StatusEffectSubsystem.h"
+#include "../Core/Telemetry/GameplayTelemetry.h"
+#include "Misc/AutomationTest.h"
+
+static constexpr EAutomationTestFlags GameplayBenchmarkFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter;
+
+namespace
+{
+    // One line per measurement, easy to grep out of the automation log
+    void ReportBenchmark(FAutomationTestBase& Test, const FString& Name, const FBenchmarkResult& Result)
+    {
+        Test.AddInfo(FString::Printf(TEXT("BENCH %-40s %10.1f ns/op %8.2f allocs/op"), *Name, Result.NsPerOp, Result.AllocsPerOp));
+    }
+
+    void ReportBytes(FAutomationTestBase& Test, const FString& Name, int32 TotalBytes, int32 NumSlots)
+    {
+        Test.AddInfo(FString::Printf(TEXT("BENCH %-40s %10d bytes %8.2f bytes/slot"), *Name, TotalBytes, double(TotalBytes) / FMath::Max(1, NumSlots)));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryBenchmark, "RELikeMultiPlayer.Benchmark.Inventory", GameplayBenchmarkFlags)
+
+bool FInventoryBenchmark::RunTest(const FString& Parameters)
+{
+    static const int32 InventorySizes[] = { 8, 64, 256 };
+
+    for (const int32 NumSlots : InventorySizes)
+    {
+        for (const bool bStackable : { true, false })
+        {
+            FGameplayTestEnvironment Environment;
+            AActor* Actor = Environment.SpawnActor();
+            UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+            FGameplayTestAccess::SetInventorySize(Inventory, 8, NumSlots / 8);
+            Environment.BeginPlay(Actor);
+
+            // Stackable adds of 7 merge into partial stacks; unique items take one slot each
+            const FString ItemID = bStackable ? FGameplayTestEnvironment::StackableItemID : FGameplayTestEnvironment::UniqueItemID;
+            const int32 AddQuantity = bStackable ? 7 : 1;
+            const int32 SlotCount = NumSlots;
+            const int32 FilledSlots = bStackable ? FMath::DivideAndRoundUp(SlotCount * AddQuantity, 30) : SlotCount;
+            const FString Label = FString::Printf(TEXT("%s/%d"), bStackable ? TEXT("Stacked") : TEXT("Unique"), SlotCount);
+
+            auto Clear = [Inventory]() { Inventory->ClearInventory(); };
+            auto Fill = [Inventory, &ItemID, AddQuantity, SlotCount]()
+            {
+                Inventory->ClearInventory();
+                for (int32 i = 0; i < SlotCount; i++)
+                {
+                    Inventory->AddItem(ItemID, AddQuantity);
+                }
+            };
+
+            ReportBenchmark(*this, Label + TEXT(" AddItem"), RunBenchmark(SlotCount, Clear,
+                [Inventory, &ItemID, AddQuantity](int32) { Inventory->AddItem(ItemID, AddQuantity); }));
+
+            ReportBenchmark(*this, Label + TEXT(" RemoveItem"), RunBenchmark(SlotCount, Fill,
+                [Inventory, FilledSlots](int32 i) { Inventory->RemoveItem(i % FilledSlots, 1); }));
+
+            ReportBenchmark(*this, Label + TEXT(" SwapItems"), RunBenchmark(SlotCount, Fill,
+                [Inventory, SlotCount](int32 i) { Inventory->SwapItems(i, SlotCount - 1 - i); }));
+
+            int32 Sink = 0;
+            ReportBenchmark(*this, Label + TEXT(" GetItemCount"), RunBenchmark(SlotCount, Fill,
+                [Inventory, &ItemID, &Sink](int32) { Sink += Inventory->GetItemCount(ItemID); }));
+            TestTrue(TEXT("Item count is non-zero"), Sink > 0);
+
+            // Payload of a full snapshot as sent to a newly relevant connection
+            Fill();
+            int32 TotalBytes = 0;
+            for (int32 i = 0; i < SlotCount; i++)
+            {
+                TotalBytes += FGameplayTestAccess::GetSlotPayloadBytes(Inventory, i);
+            }
+            ReportBytes(*this, Label + TEXT(" replicated slots"), TotalBytes, SlotCount);
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryModelBenchmark, "RELikeMultiPlayer.Benchmark.InventoryModel", GameplayBenchmarkFlags)
+
+bool FInventoryModelBenchmark::RunTest(const FString& Parameters)
+{
+    // The bare rules without a world, transactions or replication
+    static const FInventoryModelItem Items[] = { { true, 30, FIntPoint(1, 1) }, { false, 1, FIntPoint(1, 1) } };
+    static const int32 NumSlots = 256;
+
+    FInventoryModel Model;
+    Model.Reset(8, NumSlots / 8, false, Items);
+    auto Clear = [&Model]() { Model.Reset(8, NumSlots / 8, false, Items); };
+    auto Fill = [&Model]()
+    {
+        Model.Reset(8, NumSlots / 8, false, Items);
+        Model.Add(1, NumSlots);
+    };
+
+    ReportBenchmark(*this, TEXT("Model/256 Add (stacked)"), RunBenchmark(NumSlots, Clear,
+        [&Model](int32) { Model.Add(0, 7); }));
+
+    ReportBenchmark(*this, TEXT("Model/256 Swap"), RunBenchmark(NumSlots, Fill,
+        [&Model](int32 i) { Model.Swap(i, NumSlots - 1 - i); }));
+
+    ReportBenchmark(*this, TEXT("Model/256 Remove"), RunBenchmark(NumSlots, Fill,
+        [&Model](int32 i) { Model.Remove(i, 1); }));
+
+    int32 Sink = 0;
+    ReportBenchmark(*this, TEXT("Model/256 GetAddableQuantity"), RunBenchmark(NumSlots, Clear,
+        [&Model, &Sink](int32) { Sink += Model.GetAddableQuantity(0); }));
+    TestTrue(TEXT("Capacity is non-zero"), Sink > 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHealthStaminaBenchmark, "RELikeMultiPlayer.Benchmark.HealthStamina", GameplayBenchmarkFlags)
+
+bool FHealthStaminaBenchmark::RunTest(const FString& Parameters)
+{
+    static const int32 NumOps = 10000;
+
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UHealthComponent* Health = Environment.AddComponent<UHealthComponent>(Actor);
+    UStaminaComponent* Stamina = Environment.AddComponent<UStaminaComponent>(Actor);
+    Environment.BeginPlay(Actor);
+
+    // Alternating hits and heals around 50 HP cross the Injured/Wounded boundary every other op
+    ReportBenchmark(*this, TEXT("Health TakeDamage+Heal"), RunBenchmark(NumOps,
+        [Health]() { FGameplayTestAccess::SetHealth(Health, 50.0f); },
+        [Health](int32 i)
+        {
+            if (i % 2 == 0) Health->TakeDamage(1.0f);
+            else Health->Heal(1.0f);
+        }));
+
+    // Twelve pellets a frame applied as one hit, then healed back so health stays around 50 HP
+    ReportBenchmark(*this, TEXT("Health 12 hits/frame+Heal"), RunBenchmark(NumOps,
+        [Health]() { FGameplayTestAccess::SetHealth(Health, 50.0f); },
+        [Health](int32)
+        {
+            for (int32 Pellet = 0; Pellet < 12; Pellet++)
+            {
+                Health->TakeDamage(0.25f);
+            }
+            Health->Heal(3.0f);
+        }));
+
+    ReportBenchmark(*this, TEXT("Stamina tick (running)"), RunBenchmark(NumOps,
+        [Stamina]() { FGameplayTestAccess::SetStamina(Stamina, 100.0f); Stamina->StartRunning(); },
+        [Stamina](int32) { FGameplayTestAccess::TickStamina(Stamina, 1.0f / 1000.0f); }));
+
+    ReportBenchmark(*this, TEXT("Stamina tick (regenerating)"), RunBenchmark(NumOps,
+        [Stamina]() { Stamina->StopRunning(); FGameplayTestAccess::SetStamina(Stamina, 0.5f); },
+        [Stamina](int32) { FGameplayTestAccess::TickStamina(Stamina, 1.0f / 1000.0f); }));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStatusEffectBenchmark, "RELikeMultiPlayer.Benchmark.StatusEffects", GameplayBenchmarkFlags)
+
+bool FStatusEffectBenchmark::RunTest(const FString& Parameters)
+{
+    static const int32 NumActors = 64;
+    static const int32 NumSteps = 1000;
+
+    FGameplayTestEnvironment Environment;
+    UStatusEffectSubsystem* StatusEffects = UStatusEffectSubsystem::Get(Environment.GetWorld());
+    if (!TestNotNull(TEXT("Subsystem exists in game worlds"), StatusEffects)) return false;
+
+    TArray<AActor*> Actors;
+    TArray<UHealthComponent*> Healths;
+    for (int32 i = 0; i < NumActors; i++)
+    {
+        AActor* Actor = Environment.SpawnActor();
+        Healths.Add(Environment.AddComponent<UHealthComponent>(Actor));
+        Environment.AddComponent<UStaminaComponent>(Actor);
+        Environment.BeginPlay(Actor);
+        Actors.Add(Actor);
+    }
+
+    // Every actor bleeding and poisoned, slowly enough to stay alive through every step
+    auto Setup = [&]()
+    {
+        for (int32 i = 0; i < NumActors; i++)
+        {
+            FGameplayTestAccess::SetHealth(Healths[i], 100.0f);
+            StatusEffects->ApplyEffect(Actors[i], EStatusEffectType::Bleed, 0.02f, 1.0e6f);
+            StatusEffects->ApplyEffect(Actors[i], EStatusEffectType::Poison, 0.02f, 1.0e6f);
+        }
+    };
+
+    ReportBenchmark(*this, TEXT("StatusEffects/64 actors x2 step"), RunBenchmark(NumSteps, Setup,
+        [&](int32)
+        {
+            StatusEffects->Step();
+            for (UHealthComponent* Health : Healths)
+            {
+                Health->FlushPendingDamage();
+            }
+        }));
+    TestEqual(TEXT("Every effect still active"), StatusEffects->GetNumEffects(), NumActors * 2);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLagCompensationBenchmark, "RELikeMultiPlayer.Benchmark.LagCompensation", GameplayBenchmarkFlags)
+
+bool FLagCompensationBenchmark::RunTest(const FString& Parameters)
+{
+    static const int32 NumActors = 64;
+    static const int32 NumTicks = 1000;
+
+    FGameplayTestEnvironment Environment;
+    AActor* Shooter = Environment.SpawnActor();
+    ULagCompensationComponent* ShooterLag = Environment.AddComponent<ULagCompensationComponent>(Shooter);
+    Environment.BeginPlay(Shooter);
+
+    TArray<AActor*> Targets;
+    TArray<ULagCompensationComponent*> Histories;
+    for (int32 i = 0; i < NumActors; i++)
+    {
+        AActor* Target = Environment.SpawnActor();
+        Environment.AddComponent<UCapsuleComponent>(Target)->SetCapsuleSize(34.0f, 88.0f);
+        Histories.Add(Environment.AddComponent<ULagCompensationComponent>(Target));
+        Environment.BeginPlay(Target);
+        Targets.Add(Target);
+    }
+
+    // What every server tick costs: one snapshot per character, wrapping the ring many times over
+    double Time = 0.0;
+    ReportBenchmark(*this, TEXT("LagCompensation/64 record"), RunBenchmark(NumTicks, []() {},
+        [&](int32)
+        {
+            Time += 1.0 / 60.0;
+            for (ULagCompensationComponent* History : Histories)
+            {
+                History->RecordSnapshot(Time);
+            }
+        }));
+
+    int32 NumHits = 0;
+    ReportBenchmark(*this, TEXT("LagCompensation/validate"), RunBenchmark(NumTicks, []() {},
+        [&](int32 i)
+        {
+            NumHits += ShooterLag->ValidateHit(Targets[i % NumActors], FVector(-1000.0, 0.0, 0.0), FVector(1000.0, 0.0, 0.0), Time - 0.1) ? 1 : 0;
+        }));
+    TestTrue(TEXT("Rewound targets are hit"), NumHits > 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayTelemetryBenchmark, "RELikeMultiPlayer.Benchmark.Telemetry", GameplayBenchmarkFlags)
+
+bool FGameplayTelemetryBenchmark::RunTest(const FString& Parameters)
+{
+    static const int32 NumOps = 100000;
+
+    FGameplayTestEnvironment Environment;
+    AActor* Victim = Environment.SpawnActor();
+    AActor* Attacker = Environment.SpawnActor();
+
+    ReportBenchmark(*this, TEXT("Telemetry Record"), RunBenchmark(NumOps, []() {},
+        [Victim, Attacker](int32 i) { FGameplayTelemetry::Record(ETelemetryEvent::Damage, Victim, Attacker, 1.0f, i); }));
+
+    TArray<FTelemetryRecord> Records;
+    ReportBenchmark(*this, TEXT("Telemetry Snapshot (full ring)"), RunBenchmark(10, []() {},
+        [&Records](int32) { FGameplayTelemetry::Get().Snapshot(Records); }));
+    TestEqual(TEXT("Ring full"), Records.Num(), FGameplayTelemetry::Capacity);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
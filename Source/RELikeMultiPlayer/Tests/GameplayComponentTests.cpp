@@ -0,0 +1,780 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameplayTestEnvironment.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "../Components/Inventory/InventoryComponent.h"
+#include "../Components/Health/HealthComponent.h"
+#include "../Components/Stamina/StaminaComponent.h"
+#include "../Components/Combat/LagCompensationComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "../Core/Net/QuantizedVital.h"
+#include "../Core/Subsystems/StatusEffectSubsystem.h"
+#include "../Core/Telemetry/GameplayTelemetry.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/CoreNet.h"
+
+static constexpr EAutomationTestFlags GameplayTestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryStackingTest, "RELikeMultiPlayer.Inventory.Stacking", GameplayTestFlags)
+
+bool FInventoryStackingTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 2);
+    Environment.BeginPlay(Actor);
+
+    const FString Ammo = FGameplayTestEnvironment::StackableItemID;
+    const FString Key = FGameplayTestEnvironment::UniqueItemID;
+
+    TestTrue(TEXT("Add 45 ammo"), Inventory->AddItem(Ammo, 45));
+    TestEqual(TEXT("Ammo fills one stack and part of another"), Inventory->GetSlot(0).Quantity, 30);
+    TestEqual(TEXT("Second ammo stack"), Inventory->GetSlot(1).Quantity, 15);
+    TestTrue(TEXT("Add 10 more ammo"), Inventory->AddItem(Ammo, 10));
+    TestEqual(TEXT("Partial stack is topped up first"), Inventory->GetSlot(1).Quantity, 25);
+    TestEqual(TEXT("Ammo count"), Inventory->GetItemCount(Ammo), 55);
+
+    TestTrue(TEXT("Add a key"), Inventory->AddItem(Key, 1));
+    TestTrue(TEXT("Add another key"), Inventory->AddItem(Key, 1));
+    TestFalse(TEXT("A full inventory rejects more keys"), Inventory->AddItem(Key, 1));
+
+    TestTrue(TEXT("Remove ammo"), Inventory->RemoveItem(1, 25));
+    TestEqual(TEXT("Emptied slot is free"), Inventory->GetSlot(1).Quantity, 0);
+    TestEqual(TEXT("Ammo count after removal"), Inventory->GetItemCount(Ammo), 30);
+
+    TestTrue(TEXT("Swap slots"), Inventory->SwapItems(0, 2));
+    TestEqual(TEXT("Key moved to slot 0"), Inventory->GetSlot(0).ItemID, Key);
+    TestEqual(TEXT("Ammo moved to slot 2"), Inventory->GetSlot(2).Quantity, 30);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryTransactionTest, "RELikeMultiPlayer.Inventory.Transactions", GameplayTestFlags)
+
+bool FInventoryTransactionTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 1);
+    Environment.BeginPlay(Actor);
+
+    const FString Ammo = FGameplayTestEnvironment::StackableItemID;
+
+    // 70 ammo needs three stacks, so nothing may be added
+    TestFalse(TEXT("Oversized add fails"), Inventory->AddItem(Ammo, 70));
+    TestEqual(TEXT("Failed add leaves no ammo behind"), Inventory->GetItemCount(Ammo), 0);
+
+    TestTrue(TEXT("Add 20 ammo"), Inventory->AddItem(Ammo, 20));
+
+    // Split a stack, then discard both halves in one batch
+    TArray<FInventoryOp> Ops;
+    Ops.Add(FInventoryOp::MakeMove(0, 1, 5));
+    Ops.Add(FInventoryOp::MakeRemove(1, 5));
+    Ops.Add(FInventoryOp::MakeRemove(0, 15));
+    TestTrue(TEXT("Valid batch applies"), Inventory->ApplyInventoryOps(Ops));
+    TestEqual(TEXT("Batch removed all ammo"), Inventory->GetItemCount(Ammo), 0);
+
+    // The add works on its own but slot 1 is empty, so the whole batch rolls back
+    Ops.Reset();
+    Ops.Add(FInventoryOp::MakeAdd(FItemHandle(0), 10)); // First row of the test table
+    Ops.Add(FInventoryOp::MakeRemove(1, 1));
+    TestFalse(TEXT("Batch with a failing op is rejected"), Inventory->ApplyInventoryOps(Ops));
+    TestEqual(TEXT("Rejected batch leaves the count unchanged"), Inventory->GetItemCount(Ammo), 0);
+
+    // Clients cannot add items, but the batch is still acknowledged so they roll back
+    Ops.Reset();
+    Ops.Add(FInventoryOp::MakeAdd(FItemHandle(0), 10));
+    TestEqual(TEXT("Client batch with an add is acknowledged"), FGameplayTestAccess::ReceiveClientOps(Inventory, Ops, 1), 1);
+    TestEqual(TEXT("Client batch with an add is not applied"), Inventory->GetItemCount(Ammo), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySortTest, "RELikeMultiPlayer.Inventory.SortAndCompact", GameplayTestFlags)
+
+bool FInventorySortTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 2);
+    Environment.BeginPlay(Actor);
+
+    const FString Ammo = FGameplayTestEnvironment::StackableItemID;
+    const FString Key = FGameplayTestEnvironment::UniqueItemID;
+    const FString Bandage = FGameplayTestEnvironment::MedicalItemID;
+
+    // Key, split ammo stack, bandage
+    TestTrue(TEXT("Add key"), Inventory->AddItem(Key, 1));
+    TestTrue(TEXT("Add ammo"), Inventory->AddItem(Ammo, 20));
+    TestTrue(TEXT("Split the ammo"), Inventory->ApplyInventoryOps({ FInventoryOp::MakeMove(1, 3, 5) }));
+    TestTrue(TEXT("Add bandage"), Inventory->AddItem(Bandage, 1));
+
+    TestTrue(TEXT("Sort by category"), Inventory->SortAndCompact(EInventorySortMode::Category));
+    TestEqual(TEXT("Medical first"), Inventory->GetSlot(0).ItemID, Bandage);
+    TestEqual(TEXT("Tools next"), Inventory->GetSlot(1).ItemID, Key);
+    TestEqual(TEXT("Ammo stacks merged"), Inventory->GetSlot(2).Quantity, 20);
+    TestEqual(TEXT("Last slot freed"), Inventory->GetSlot(3).Quantity, 0);
+
+    TestTrue(TEXT("Sort by ID"), Inventory->SortAndCompact(EInventorySortMode::ItemID));
+    TestEqual(TEXT("test_ammo first"), Inventory->GetSlot(0).ItemID, Ammo);
+    TestEqual(TEXT("test_bandage second"), Inventory->GetSlot(1).ItemID, Bandage);
+    TestEqual(TEXT("test_key third"), Inventory->GetSlot(2).ItemID, Key);
+    TestEqual(TEXT("Ammo count unchanged"), Inventory->GetItemCount(Ammo), 20);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryUseEffectTest, "RELikeMultiPlayer.Inventory.UseEffects", GameplayTestFlags)
+
+bool FInventoryUseEffectTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UHealthComponent* Health = Environment.AddComponent<UHealthComponent>(Actor);
+    UStaminaComponent* Stamina = Environment.AddComponent<UStaminaComponent>(Actor);
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 2);
+    Environment.BeginPlay(Actor);
+
+    const FString Bandage = FGameplayTestEnvironment::MedicalItemID;
+    const FString Energy = FGameplayTestEnvironment::StaminaItemID;
+    const FString Key = FGameplayTestEnvironment::UniqueItemID;
+    const FString Ammo = FGameplayTestEnvironment::StackableItemID;
+
+    TestTrue(TEXT("Add bandages"), Inventory->AddItem(Bandage, 2));
+    TestTrue(TEXT("Add energy drink"), Inventory->AddItem(Energy, 1));
+    TestTrue(TEXT("Add key"), Inventory->AddItem(Key, 1));
+
+    FGameplayTestAccess::SetHealth(Health, 40.0f);
+    TestTrue(TEXT("Use bandage"), Inventory->UseItem(0));
+    TestEqual(TEXT("Medical rows without an authored effect heal 25"), Health->GetHealthPercentage(), 0.65f);
+    TestEqual(TEXT("Bandage consumed"), Inventory->GetItemCount(Bandage), 1);
+
+    FGameplayTestAccess::SetStamina(Stamina, 10.0f);
+    TestTrue(TEXT("Use energy drink"), Inventory->UseItem(1));
+    TestEqual(TEXT("Authored effect restores stamina"), Stamina->GetStaminaPercentage(), 0.5f);
+    TestEqual(TEXT("Energy drink consumed"), Inventory->GetItemCount(Energy), 0);
+
+    TestTrue(TEXT("Use key"), Inventory->UseItem(2));
+    TestEqual(TEXT("Tools are not consumed"), Inventory->GetItemCount(Key), 1);
+
+    TestTrue(TEXT("Add ammo to the freed slot"), Inventory->AddItem(Ammo, 1));
+    TestFalse(TEXT("Items without an effect cannot be used"), Inventory->UseItem(1));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryCombineTest, "RELikeMultiPlayer.Inventory.Combine", GameplayTestFlags)
+
+bool FInventoryCombineTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 2);
+    Environment.BeginPlay(Actor);
+
+    const FString Herb = FGameplayTestEnvironment::HerbItemID;
+    const FString Energy = FGameplayTestEnvironment::StaminaItemID;
+    const FString Bandage = FGameplayTestEnvironment::MedicalItemID;
+    const FString Key = FGameplayTestEnvironment::UniqueItemID;
+
+    TestTrue(TEXT("Add energy drinks"), Inventory->AddItem(Energy, 2));
+    TestTrue(TEXT("Add herbs"), Inventory->AddItem(Herb, 3));
+    TestTrue(TEXT("Add key"), Inventory->AddItem(Key, 1));
+
+    TestFalse(TEXT("Items without a recipe do not combine"), Inventory->CombineItems(0, 2));
+
+    auto CountPickups = [Actor]()
+    {
+        TArray<FTelemetryRecord> Events;
+        FGameplayTelemetry::Get().Snapshot(Events);
+        return Events.FilterByPredicate([Actor](const FTelemetryRecord& Event)
+        {
+            return Event.Type == ETelemetryEvent::ItemPickedUp && Event.ActorId == Actor->GetUniqueID();
+        }).Num();
+    };
+    const int32 PickupsBefore = CountPickups();
+
+    // Authored on the herb row, combined from the energy drink side. The energy drink slot keeps one, so the result is stowed.
+    TestTrue(TEXT("Combine in reverse ingredient order"), Inventory->CombineItems(0, 1));
+    TestEqual(TEXT("Herbs consumed"), Inventory->GetItemCount(Herb), 1);
+    TestEqual(TEXT("Energy drink consumed"), Inventory->GetItemCount(Energy), 1);
+    TestEqual(TEXT("Bandages produced"), Inventory->GetItemCount(Bandage), 2);
+    TestEqual(TEXT("Combining is not a pickup"), CountPickups(), PickupsBefore);
+
+    TestFalse(TEXT("Not enough herbs left"), Inventory->CombineItems(1, 0));
+    TestEqual(TEXT("Failed combine changes nothing"), Inventory->GetItemCount(Energy), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryGridTest, "RELikeMultiPlayer.Inventory.GridLayout", GameplayTestFlags)
+
+bool FInventoryGridTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Case = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetGridLayout(Case, 4, 2);
+    UInventoryComponent* Narrow = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetGridLayout(Narrow, 2, 3);
+    Environment.BeginPlay(Actor);
+
+    const FString Rifle = FGameplayTestEnvironment::LongItemID;
+    const FString Key = FGameplayTestEnvironment::UniqueItemID;
+
+    // 4x2 case: rifles take three cells of a row each
+    TestTrue(TEXT("Add a rifle"), Case->AddItem(Rifle, 1));
+    TestEqual(TEXT("Rifle footprint"), Case->GetSlotFootprint(0), FIntPoint(3, 1));
+    TestTrue(TEXT("Add a key"), Case->AddItem(Key, 1));
+    TestEqual(TEXT("Key fills the cell next to the rifle"), Case->GetSlot(3).ItemID, Key);
+    TestTrue(TEXT("Add a second rifle"), Case->AddItem(Rifle, 1));
+    TestEqual(TEXT("Second rifle starts the next row"), Case->GetSlot(4).ItemID, Rifle);
+    TestFalse(TEXT("No room for a third rifle"), Case->AddItem(Rifle, 1));
+    TestFalse(TEXT("A 1x3 rifle does not fit two rows"), Case->RotateItem(0));
+
+    TestFalse(TEXT("Cannot move onto cells covered by another item"), Case->SwapItems(3, 1));
+    TestTrue(TEXT("Remove the key"), Case->RemoveItem(3, 1));
+    TestTrue(TEXT("Shift the second rifle right over its own cells"), Case->ApplyInventoryOps({ FInventoryOp::MakeMove(4, 5, 1) }));
+    TestEqual(TEXT("Moved rifle"), Case->GetSlotFootprint(5), FIntPoint(3, 1));
+    TestTrue(TEXT("Add a key"), Case->AddItem(Key, 1));
+    TestEqual(TEXT("The freed cell is reused"), Case->GetSlot(3).ItemID, Key);
+    TestTrue(TEXT("Add another key"), Case->AddItem(Key, 1));
+    TestEqual(TEXT("The cell left of the moved rifle is free"), Case->GetSlot(4).ItemID, Key);
+
+    // 2x3 case: the rifle only fits turned on its side
+    TestTrue(TEXT("Add a rifle to the narrow case"), Narrow->AddItem(Rifle, 1));
+    TestTrue(TEXT("Placed rotated"), Narrow->GetSlot(0).bRotated);
+    TestEqual(TEXT("Rotated footprint"), Narrow->GetSlotFootprint(0), FIntPoint(1, 3));
+    TestFalse(TEXT("Cannot rotate back"), Narrow->RotateItem(0));
+    TestTrue(TEXT("The other column is free"), Narrow->AddItem(Key, 3));
+    TestFalse(TEXT("Narrow case is full"), Narrow->AddItem(Key, 1));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySummaryTest, "RELikeMultiPlayer.Inventory.PublicSummary", GameplayTestFlags)
+
+bool FInventorySummaryTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 2);
+    Environment.BeginPlay(Actor);
+
+    TestEqual(TEXT("Total slots published"), Inventory->GetSummary().TotalSlots, 4);
+    TestFalse(TEXT("No key item yet"), Inventory->GetSummary().bHasKeyItem);
+
+    TestTrue(TEXT("Add ammo"), Inventory->AddItem(FGameplayTestEnvironment::StackableItemID, 10));
+    TestTrue(TEXT("Add key"), Inventory->AddItem(FGameplayTestEnvironment::UniqueItemID, 1));
+    const int32 Version = Inventory->GetSummary().Version;
+    TestEqual(TEXT("Occupied slots published"), Inventory->GetSummary().OccupiedSlots, 2);
+    TestTrue(TEXT("Key item published"), Inventory->GetSummary().bHasKeyItem);
+
+    TestTrue(TEXT("Discard key"), Inventory->RemoveItem(1, 1));
+    TestFalse(TEXT("Key item cleared"), Inventory->GetSummary().bHasKeyItem);
+    TestEqual(TEXT("Version advances per commit"), Inventory->GetSummary().Version, Version + 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySlotConditionTest, "RELikeMultiPlayer.Inventory.SlotReplicationCondition", GameplayTestFlags)
+
+bool FInventorySlotConditionTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Player = Environment.SpawnActor();
+    UInventoryComponent* Backpack = Environment.AddComponent<UInventoryComponent>(Player);
+    Environment.BeginPlay(Player);
+
+    AActor* Crate = Environment.SpawnActor();
+    UInventoryComponent* Shared = Environment.AddComponent<UInventoryComponent>(Crate);
+    FGameplayTestAccess::SetReplicateSlotsToOwnerOnly(Shared, false);
+    Environment.BeginPlay(Crate);
+
+    TestTrue(TEXT("Slots go to the owner only by default"), FGameplayTestAccess::GetSlotsCondition(Backpack) == COND_OwnerOnly);
+    TestTrue(TEXT("Shared container slots go to everyone"), FGameplayTestAccess::GetSlotsCondition(Shared) == COND_None);
+    TestTrue(TEXT("Attributes follow the owner-only slots"), FGameplayTestAccess::GetAttributesCondition(Backpack) == COND_OwnerOnly);
+    TestTrue(TEXT("Attributes follow the shared slots"), FGameplayTestAccess::GetAttributesCondition(Shared) == COND_None);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryTransferTest, "RELikeMultiPlayer.Inventory.Transfer", GameplayTestFlags)
+
+bool FInventoryTransferTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* SourceActor = Environment.SpawnActor();
+    UInventoryComponent* Source = Environment.AddComponent<UInventoryComponent>(SourceActor);
+    FGameplayTestAccess::SetInventorySize(Source, 2, 2);
+    Environment.BeginPlay(SourceActor);
+
+    AActor* TargetActor = Environment.SpawnActor();
+    UInventoryComponent* Target = Environment.AddComponent<UInventoryComponent>(TargetActor);
+    FGameplayTestAccess::SetInventorySize(Target, 2, 1);
+    Environment.BeginPlay(TargetActor);
+
+    const FString Ammo = FGameplayTestEnvironment::StackableItemID;
+    const FString Key = FGameplayTestEnvironment::UniqueItemID;
+
+    TestEqual(TEXT("Two empty slots hold two stacks"), Target->GetAddableQuantity(Ammo), 60);
+    TestTrue(TEXT("Add ammo to the target"), Target->AddItem(Ammo, 25));
+    TestTrue(TEXT("Add key to the target"), Target->AddItem(Key, 1));
+    TestEqual(TEXT("Only the partial stack has room"), Target->GetAddableQuantity(Ammo), 5);
+    TestEqual(TEXT("Capacity query changes nothing"), Target->GetItemCount(Ammo), 25);
+
+    TestTrue(TEXT("Add ammo to the source"), Source->AddItem(Ammo, 20));
+    TestFalse(TEXT("Transfer larger than the free space"), Source->TransferItem(0, Target, 20));
+    TestEqual(TEXT("Failed transfer leaves the source"), Source->GetItemCount(Ammo), 20);
+    TestEqual(TEXT("Failed transfer leaves the target"), Target->GetItemCount(Ammo), 25);
+
+    // Neither actor belongs to a player, so a client asking for the same transfer has no say over the target
+    FGameplayTestAccess::ReceiveClientTransfer(Source, 0, Target, 5);
+    TestEqual(TEXT("Client transfer into a container it cannot view is refused"), Target->GetItemCount(Ammo), 25);
+
+    TestTrue(TEXT("Transfer that fits"), Source->TransferItem(0, Target, 5));
+    TestEqual(TEXT("Taken from the source"), Source->GetItemCount(Ammo), 15);
+    TestEqual(TEXT("Given to the target"), Target->GetItemCount(Ammo), 30);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryAttributeTest, "RELikeMultiPlayer.Inventory.ItemAttributes", GameplayTestFlags)
+
+bool FInventoryAttributeTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 2);
+    Environment.BeginPlay(Actor);
+
+    const FString Ammo = FGameplayTestEnvironment::StackableItemID;
+    const FString Key = FGameplayTestEnvironment::UniqueItemID;
+
+    TestTrue(TEXT("Add ammo"), Inventory->AddItem(Ammo, 10));
+    TestTrue(TEXT("Add key"), Inventory->AddItem(Key, 1));
+    TestFalse(TEXT("Empty slots carry no attributes"), Inventory->SetItemAttribute(3, EItemAttribute::Durability, 5));
+    TestTrue(TEXT("Set durability"), Inventory->SetItemAttribute(1, EItemAttribute::Durability, 80));
+    TestEqual(TEXT("Unset attributes read the default"), Inventory->GetItemAttribute(0, EItemAttribute::Durability, -1), -1);
+
+    TestTrue(TEXT("Swap key and ammo"), Inventory->SwapItems(0, 1));
+    TestEqual(TEXT("Durability follows the key"), Inventory->GetItemAttribute(0, EItemAttribute::Durability), 80);
+    TestEqual(TEXT("Old slot has none"), Inventory->GetItemAttribute(1, EItemAttribute::Durability, -1), -1);
+
+    // The failing op rolls the move back, and the attribute with it
+    TArray<FInventoryOp> Ops;
+    Ops.Add(FInventoryOp::MakeMove(0, 3, 1));
+    Ops.Add(FInventoryOp::MakeUse(2));
+    TestFalse(TEXT("Batch with a failing op"), Inventory->ApplyInventoryOps(Ops));
+    TestEqual(TEXT("Rollback restores the attribute"), Inventory->GetItemAttribute(0, EItemAttribute::Durability), 80);
+
+    TestTrue(TEXT("Sort"), Inventory->SortAndCompact(EInventorySortMode::ItemID));
+    const int32 KeySlot = Inventory->GetSlot(0).ItemID == Key ? 0 : 1;
+    TestEqual(TEXT("Sort carries the attribute"), Inventory->GetItemAttribute(KeySlot, EItemAttribute::Durability), 80);
+
+    TestTrue(TEXT("Discard key"), Inventory->RemoveItem(KeySlot, 1));
+    TestEqual(TEXT("Emptied slots lose their attributes"), Inventory->GetItemAttribute(KeySlot, EItemAttribute::Durability, -1), -1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryViewTest, "RELikeMultiPlayer.Inventory.QueryViews", GameplayTestFlags)
+
+bool FInventoryViewTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UInventoryComponent* Inventory = Environment.AddComponent<UInventoryComponent>(Actor);
+    FGameplayTestAccess::SetInventorySize(Inventory, 2, 2);
+    Environment.BeginPlay(Actor);
+
+    TestTrue(TEXT("Add ammo"), Inventory->AddItem(FGameplayTestEnvironment::StackableItemID, 10));
+    TestTrue(TEXT("Add bandages"), Inventory->AddItem(FGameplayTestEnvironment::MedicalItemID, 2));
+    TestTrue(TEXT("Add herbs"), Inventory->AddItem(FGameplayTestEnvironment::HerbItemID, 3));
+
+    TestEqual(TEXT("View covers every slot"), Inventory->GetSlots().Num(), 4);
+    TestTrue(TEXT("FindSlot reads in place"), Inventory->FindSlot(1) == &Inventory->GetSlots()[1]);
+    TestNull(TEXT("FindSlot rejects bad indices"), Inventory->FindSlot(4));
+
+    int32 NumItems = 0;
+    Inventory->ForEachItem([&NumItems](const FInventorySlot&) { NumItems++; });
+    TestEqual(TEXT("ForEachItem skips empty slots"), NumItems, 3);
+
+    TArray<int32> SlotIndices;
+    Inventory->GetSlotIndicesInCategory(EItemCategory::Medical, SlotIndices);
+    TestEqual(TEXT("Two medical stacks"), SlotIndices.Num(), 2);
+    TestEqual(TEXT("Herbs are the second medical stack"), Inventory->GetSlotQuantity(SlotIndices[1]), 3);
+    Inventory->GetOccupiedSlotIndices(SlotIndices);
+    TestEqual(TEXT("Refilled in place"), SlotIndices.Num(), 3);
+    TestEqual(TEXT("Empty slots read as zero"), Inventory->GetSlotQuantity(3), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHealthStateTest, "RELikeMultiPlayer.Health.StateTransitions", GameplayTestFlags)
+
+bool FHealthStateTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UHealthComponent* Health = Environment.AddComponent<UHealthComponent>(Actor);
+    Environment.BeginPlay(Actor);
+
+    TestEqual(TEXT("Starts healthy"), Health->GetHealthState(), EHealthState::Healthy);
+    Health->TakeDamage(30.0f);
+    Health->FlushPendingDamage();
+    TestEqual(TEXT("70 HP is injured"), Health->GetHealthState(), EHealthState::Injured);
+    Health->TakeDamage(25.0f);
+    Health->FlushPendingDamage();
+    TestEqual(TEXT("45 HP is wounded"), Health->GetHealthState(), EHealthState::Wounded);
+    Health->TakeDamage(25.0f);
+    Health->FlushPendingDamage();
+    TestEqual(TEXT("20 HP is critical"), Health->GetHealthState(), EHealthState::Critical);
+    Health->TakeDamage(50.0f);
+    Health->FlushPendingDamage();
+    TestEqual(TEXT("0 HP is downed"), Health->GetHealthState(), EHealthState::Downed);
+    TestTrue(TEXT("Downed flag set"), Health->IsDowned());
+
+    Health->Heal(30.0f);
+    TestEqual(TEXT("Healing a downed player to 30 HP"), Health->GetHealthState(), EHealthState::Wounded);
+    TestFalse(TEXT("Healing clears downed"), Health->IsDowned());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHealthDamageQueueTest, "RELikeMultiPlayer.Health.DamageQueue", GameplayTestFlags)
+
+bool FHealthDamageQueueTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UHealthComponent* Health = Environment.AddComponent<UHealthComponent>(Actor);
+    Environment.BeginPlay(Actor);
+
+    // A shotgun blast: every pellet is queued, then applied as one hit
+    for (int32 i = 0; i < 8; i++)
+    {
+        Health->TakeDamage(5.0f);
+    }
+    TestEqual(TEXT("Hits wait for the end of the frame"), Health->GetHealthPercentage(), 1.0f);
+    TestEqual(TEXT("Hits are summed"), Health->GetPendingDamage(), 40.0f);
+
+    Health->FlushPendingDamage();
+    TestEqual(TEXT("Summed damage applied once"), Health->GetHealthPercentage(), 0.6f);
+    TestEqual(TEXT("One transition for the whole blast"), Health->GetHealthState(), EHealthState::Wounded);
+    TestEqual(TEXT("Queue emptied"), Health->GetPendingDamage(), 0.0f);
+
+    // Healing applies queued hits first, keeping the order they happened in
+    Health->TakeDamage(50.0f);
+    Health->Heal(30.0f);
+    TestEqual(TEXT("Damage then heal"), Health->GetHealthPercentage(), 0.3f);
+    TestFalse(TEXT("Downed and healed in the same frame"), Health->IsDowned());
+
+    Health->TakeDamage(20.0f);
+    Health->TakeDamage(20.0f);
+    Health->FlushPendingDamage();
+    TestEqual(TEXT("A lethal frame downs"), Health->GetHealthState(), EHealthState::Downed);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStatusEffectTest, "RELikeMultiPlayer.StatusEffects.BatchedSteps", GameplayTestFlags)
+
+bool FStatusEffectTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UHealthComponent* Health = Environment.AddComponent<UHealthComponent>(Actor);
+    UStaminaComponent* Stamina = Environment.AddComponent<UStaminaComponent>(Actor);
+    Environment.BeginPlay(Actor);
+
+    UStatusEffectSubsystem* StatusEffects = UStatusEffectSubsystem::Get(Environment.GetWorld());
+    if (!TestNotNull(TEXT("Subsystem exists in game worlds"), StatusEffects)) return false;
+
+    TestFalse(TEXT("Actors without vitals are rejected"), StatusEffects->ApplyEffect(Environment.SpawnActor(), EStatusEffectType::Bleed, 1.0f, 1.0f));
+
+    // Reapplying refreshes instead of stacking
+    TestTrue(TEXT("Bleed applied"), StatusEffects->ApplyEffect(Actor, EStatusEffectType::Bleed, 2.0f, 0.5f));
+    TestTrue(TEXT("Bleed refreshed"), StatusEffects->ApplyEffect(Actor, EStatusEffectType::Bleed, 4.0f, 1.0f));
+    TestTrue(TEXT("Poison applied"), StatusEffects->ApplyEffect(Actor, EStatusEffectType::Poison, 2.0f, 0.5f));
+    TestEqual(TEXT("One entry per effect type"), StatusEffects->GetNumEffects(), 2);
+
+    // One second of steps: bleed 4 HP/s for 1s and poison 2 HP/s and 2 stamina/s for 0.5s
+    const int32 NumSteps = FMath::RoundToInt(1.0f / StatusEffects->GetStepInterval());
+    for (int32 i = 0; i < NumSteps; i++)
+    {
+        StatusEffects->Step();
+        Health->FlushPendingDamage();
+    }
+    TestEqual(TEXT("Health lost to bleed and poison"), Health->GetHealthPercentage(), 0.95f, 0.001f);
+    TestEqual(TEXT("Stamina lost to poison"), Stamina->GetStaminaPercentage(), 0.99f, 0.001f);
+    TestEqual(TEXT("Expired effects removed"), StatusEffects->GetNumEffects(), 0);
+    TestFalse(TEXT("Bleed gone"), StatusEffects->HasEffect(Actor, EStatusEffectType::Bleed));
+
+    // Regeneration does not revive a downed player
+    FGameplayTestAccess::SetHealth(Health, 0.0f);
+    TestTrue(TEXT("Downed"), Health->IsDowned());
+    StatusEffects->ApplyEffect(Actor, EStatusEffectType::Regeneration, 10.0f, 1.0f);
+    StatusEffects->Step();
+    TestTrue(TEXT("Still downed"), Health->IsDowned());
+
+    StatusEffects->ClearEffects(Actor);
+    TestEqual(TEXT("Cleared"), StatusEffects->GetNumEffects(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCapsuleHistoryTest, "RELikeMultiPlayer.Combat.CapsuleHistory", GameplayTestFlags)
+
+bool FCapsuleHistoryTest::RunTest(const FString& Parameters)
+{
+    FCapsuleHistory History;
+    FCapsuleSnapshot Snapshot;
+    TestFalse(TEXT("Nothing to rewind"), History.Rewind(0.0, Snapshot));
+
+    // Twice the capacity at 10ms, moving 1 unit per snapshot along X
+    for (int32 i = 0; i < FCapsuleHistory::Capacity * 2; i++)
+    {
+        History.Record(i * 0.01, FVector(i, 0.0, 0.0), 88.0f, 34.0f);
+    }
+    TestEqual(TEXT("Full after wrapping"), History.GetNum(), FCapsuleHistory::Capacity);
+    TestEqual(TEXT("Oldest entries overwritten"), History.Get(0).Location.X, double(FCapsuleHistory::Capacity));
+
+    TestFalse(TEXT("Older than the history"), History.Rewind(0.5, Snapshot));
+    TestTrue(TEXT("Inside the history"), History.Rewind(1.005, Snapshot));
+    TestEqual(TEXT("Interpolated between snapshots"), Snapshot.Location.X, 100.5, 0.001);
+    TestTrue(TEXT("After the newest"), History.Rewind(10.0, Snapshot));
+    TestEqual(TEXT("Clamped to the newest"), Snapshot.Location.X, double(FCapsuleHistory::Capacity * 2 - 1));
+
+    // A trace along Y through x=100.5 hits the rewound capsule, one 50 units away does not
+    History.Rewind(1.005, Snapshot);
+    FVector HitPoint;
+    TestTrue(TEXT("Hit"), FCapsuleHistory::SegmentHitsCapsule(Snapshot, FVector(100.5, -500.0, 0.0), FVector(100.5, 500.0, 0.0), 0.0f, HitPoint));
+    TestFalse(TEXT("Miss"), FCapsuleHistory::SegmentHitsCapsule(Snapshot, FVector(150.5, -500.0, 0.0), FVector(150.5, 500.0, 0.0), 0.0f, HitPoint));
+    TestFalse(TEXT("Over the head"), FCapsuleHistory::SegmentHitsCapsule(Snapshot, FVector(100.5, -500.0, 100.0), FVector(100.5, 500.0, 100.0), 0.0f, HitPoint));
+
+    // Rewinding a component: the target has since moved out of the line of fire
+    FGameplayTestEnvironment Environment;
+    AActor* Shooter = Environment.SpawnActor();
+    ULagCompensationComponent* ShooterLag = Environment.AddComponent<ULagCompensationComponent>(Shooter);
+    AActor* Target = Environment.SpawnActor();
+    UCapsuleComponent* TargetCapsule = Environment.AddComponent<UCapsuleComponent>(Target);
+    TargetCapsule->SetCapsuleSize(34.0f, 88.0f);
+    ULagCompensationComponent* TargetLag = Environment.AddComponent<ULagCompensationComponent>(Target);
+    Environment.BeginPlay(Shooter);
+    Environment.BeginPlay(Target);
+
+    TargetCapsule->SetWorldLocation(FVector(1000.0, 0.0, 0.0));
+    TargetLag->RecordSnapshot(1.0);
+    TargetCapsule->SetWorldLocation(FVector(1000.0, 300.0, 0.0));
+    TargetLag->RecordSnapshot(1.1);
+
+    const FVector Start(0.0, 0.0, 0.0);
+    const FVector End(2000.0, 0.0, 0.0);
+    TestTrue(TEXT("Hit where the target was"), ShooterLag->ValidateHit(Target, Start, End, 1.0));
+    TestFalse(TEXT("Missed where the target is"), ShooterLag->ValidateHit(Target, Start, End, 1.1));
+    TestFalse(TEXT("Targets with nothing recorded cannot be hit"), ShooterLag->ValidateHit(Shooter, Start, End, 1.0));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitRejectionTest, "RELikeMultiPlayer.Combat.HitRejection", GameplayTestFlags)
+
+bool FHitRejectionTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Shooter = Environment.SpawnActor();
+    UCapsuleComponent* ShooterCapsule = Environment.AddComponent<UCapsuleComponent>(Shooter);
+    ShooterCapsule->SetCapsuleSize(34.0f, 88.0f);
+    ULagCompensationComponent* ShooterLag = Environment.AddComponent<ULagCompensationComponent>(Shooter);
+    AActor* Bodiless = Environment.SpawnActor();
+    ULagCompensationComponent* BodilessLag = Environment.AddComponent<ULagCompensationComponent>(Bodiless);
+    AActor* Target = Environment.SpawnActor();
+    UCapsuleComponent* TargetCapsule = Environment.AddComponent<UCapsuleComponent>(Target);
+    TargetCapsule->SetCapsuleSize(34.0f, 88.0f);
+    ULagCompensationComponent* TargetLag = Environment.AddComponent<ULagCompensationComponent>(Target);
+    Environment.BeginPlay(Shooter);
+    Environment.BeginPlay(Bodiless);
+    Environment.BeginPlay(Target);
+
+    TargetCapsule->SetWorldLocation(FVector(1000.0, 0.0, 0.0));
+    TargetLag->RecordSnapshot(Environment.GetWorld()->GetTimeSeconds());
+
+    auto CountRejections = [](const AActor* Actor, EHitRejectReason Reason)
+    {
+        TArray<FTelemetryRecord> Events;
+        FGameplayTelemetry::Get().Snapshot(Events);
+        return Events.FilterByPredicate([Actor, Reason](const FTelemetryRecord& Event)
+        {
+            return Event.Type == ETelemetryEvent::HitRejected && Event.ActorId == Actor->GetUniqueID() && Event.Extra == (int32)Reason;
+        }).Num();
+    };
+    const int32 MissedBefore = CountRejections(Shooter, EHitRejectReason::Missed);
+    const int32 FireRateBefore = CountRejections(Shooter, EHitRejectReason::FireRate);
+    const int32 OriginBefore = CountRejections(Bodiless, EHitRejectReason::TraceOrigin);
+    const int32 LengthBefore = CountRejections(Target, EHitRejectReason::TraceLength);
+
+    // The world clock does not move, so every report lands in the same fire interval
+    const FVector Start(0.0, 0.0, 0.0);
+    const FVector End(2000.0, 0.0, 0.0);
+    for (int32 i = 0; i < 5; i++)
+    {
+        ShooterLag->ConfirmHit(Target, Start, End);
+    }
+    TestEqual(TEXT("The first hit is valid"), CountRejections(Shooter, EHitRejectReason::Missed), MissedBefore);
+    TestEqual(TEXT("Hits past the fire rate are rejected"), CountRejections(Shooter, EHitRejectReason::FireRate), FireRateBefore + 4);
+
+    BodilessLag->ConfirmHit(Target, Start, End);
+    TestEqual(TEXT("Shooters without a capsule cannot hit"), CountRejections(Bodiless, EHitRejectReason::TraceOrigin), OriginBefore + 1);
+
+    TargetLag->ConfirmHit(Shooter, FVector(1000.0, 0.0, 0.0), FVector(-20000.0, 0.0, 0.0));
+    TestEqual(TEXT("Traces past the maximum length are rejected"), CountRejections(Target, EHitRejectReason::TraceLength), LengthBefore + 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRewoundTraceOriginTest, "RELikeMultiPlayer.Combat.RewoundTraceOrigin", GameplayTestFlags)
+
+bool FRewoundTraceOriginTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Shooter = Environment.SpawnActor();
+    UCapsuleComponent* ShooterCapsule = Environment.AddComponent<UCapsuleComponent>(Shooter);
+    ShooterCapsule->SetCapsuleSize(34.0f, 88.0f);
+    ULagCompensationComponent* ShooterLag = Environment.AddComponent<ULagCompensationComponent>(Shooter);
+    AActor* Target = Environment.SpawnActor();
+    UCapsuleComponent* TargetCapsule = Environment.AddComponent<UCapsuleComponent>(Target);
+    TargetCapsule->SetCapsuleSize(34.0f, 88.0f);
+    ULagCompensationComponent* TargetLag = Environment.AddComponent<ULagCompensationComponent>(Target);
+    Environment.BeginPlay(Shooter);
+    Environment.BeginPlay(Target);
+
+    // The shooter fires from the origin, then runs 600 units before the server hears of it
+    const double Now = Environment.GetWorld()->GetTimeSeconds();
+    const double FireTime = Now - 0.3;
+    TargetCapsule->SetWorldLocation(FVector(1000.0, 0.0, 0.0));
+    ShooterCapsule->SetWorldLocation(FVector::ZeroVector);
+    ShooterLag->RecordSnapshot(FireTime);
+    TargetLag->RecordSnapshot(FireTime);
+    ShooterCapsule->SetWorldLocation(FVector(600.0, 0.0, 0.0));
+    ShooterLag->RecordSnapshot(Now);
+    TargetLag->RecordSnapshot(Now);
+
+    TArray<FTelemetryRecord> Events;
+    FGameplayTelemetry::Get().Snapshot(Events);
+    const int32 RejectedBefore = Events.FilterByPredicate([Shooter](const FTelemetryRecord& Event)
+    {
+        return Event.Type == ETelemetryEvent::HitRejected && Event.ActorId == Shooter->GetUniqueID();
+    }).Num();
+
+    FGameplayTestAccess::ConfirmHitAt(ShooterLag, Target, FVector::ZeroVector, FVector(2000.0, 0.0, 0.0), FireTime);
+
+    FGameplayTelemetry::Get().Snapshot(Events);
+    const int32 RejectedAfter = Events.FilterByPredicate([Shooter](const FTelemetryRecord& Event)
+    {
+        return Event.Type == ETelemetryEvent::HitRejected && Event.ActorId == Shooter->GetUniqueID();
+    }).Num();
+    TestEqual(TEXT("The origin is checked where the shooter was when firing"), RejectedAfter, RejectedBefore);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStaminaTickTest, "RELikeMultiPlayer.Stamina.DepletionAndRegeneration", GameplayTestFlags)
+
+bool FStaminaTickTest::RunTest(const FString& Parameters)
+{
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UStaminaComponent* Stamina = Environment.AddComponent<UStaminaComponent>(Actor);
+    Environment.BeginPlay(Actor);
+
+    const float StartPercentage = Stamina->GetStaminaPercentage();
+
+    Stamina->StartSprinting();
+    for (int32 i = 0; i < 60; i++)
+    {
+        FGameplayTestAccess::TickStamina(Stamina, 1.0f / 60.0f);
+    }
+    const float SprintPercentage = Stamina->GetStaminaPercentage();
+    TestTrue(TEXT("Sprinting depletes stamina"), SprintPercentage < StartPercentage);
+
+    // Regeneration resumes after a short delay
+    Stamina->StopSprinting();
+    Environment.AdvanceTimers(1.5f);
+    for (int32 i = 0; i < 60; i++)
+    {
+        FGameplayTestAccess::TickStamina(Stamina, 1.0f / 60.0f);
+    }
+    TestTrue(TEXT("Resting regenerates stamina"), Stamina->GetStaminaPercentage() > SprintPercentage);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQuantizedVitalTest, "RELikeMultiPlayer.Net.QuantizedVital", GameplayTestFlags)
+
+bool FQuantizedVitalTest::RunTest(const FString& Parameters)
+{
+    FQuantizedVital Vital;
+    TestTrue(TEXT("Changed value is sent"), Vital.Update(33.3f, 100.0f, FQuantizedVital::MaxSteps, 1));
+    TestTrue(TEXT("Decodes within one step"), FMath::Abs(Vital.ToValue(100.0f) - 33.3f) <= 100.0f / FQuantizedVital::MaxSteps);
+
+    FNetBitWriter Writer(nullptr, 64);
+    bool bSuccess = false;
+    Vital.NetSerialize(Writer, nullptr, bSuccess);
+    TestEqual(TEXT("Sent as 10 bits"), Writer.GetNumBits(), int64(10));
+
+    // On a 100 step grid, changes inside one percent are not sent
+    TestTrue(TEXT("50%"), Vital.Update(50.0f, 100.0f, 100, 1));
+    TestFalse(TEXT("50.3% rounds to the same step"), Vital.Update(50.3f, 100.0f, 100, 1));
+    TestTrue(TEXT("50.6% is the next step"), Vital.Update(50.6f, 100.0f, 100, 1));
+    TestEqual(TEXT("Decodes on the grid"), Vital.ToValue(100.0f), 51.0f, 0.01f);
+
+    TestFalse(TEXT("Below the threshold"), Vital.Update(53.0f, 100.0f, 100, 5));
+    TestTrue(TEXT("Nearly empty is always sent"), Vital.Update(0.1f, 100.0f, 100, 5));
+    TestTrue(TEXT("Nearly empty is not empty"), Vital.ToValue(100.0f) > 0.0f);
+    TestTrue(TEXT("Empty is always sent"), Vital.Update(0.0f, 100.0f, 100, 5));
+    TestEqual(TEXT("Empty decodes to 0"), Vital.ToValue(100.0f), 0.0f);
+
+    // Sprinting drains a little every tick, but only whole HUD percents reach the wire
+    FGameplayTestEnvironment Environment;
+    AActor* Actor = Environment.SpawnActor();
+    UStaminaComponent* Stamina = Environment.AddComponent<UStaminaComponent>(Actor);
+    Environment.BeginPlay(Actor);
+
+    Stamina->StartSprinting();
+    int32 NumSent = 0;
+    uint16 LastStep = FGameplayTestAccess::GetReplicatedStamina(Stamina).Step;
+    for (int32 i = 0; i < 60; i++)
+    {
+        FGameplayTestAccess::TickStamina(Stamina, 1.0f / 60.0f);
+        const uint16 Step = FGameplayTestAccess::GetReplicatedStamina(Stamina).Step;
+        NumSent += Step != LastStep ? 1 : 0;
+        LastStep = Step;
+    }
+    TestTrue(TEXT("Stamina is sent once per percent, not every tick"), NumSent > 0 && NumSent <= 6);
+    TestEqual(TEXT("Client sees what the HUD shows"),
+        FMath::RoundToInt(FGameplayTestAccess::GetReplicatedStamina(Stamina).ToValue(100.0f)),
+        FMath::RoundToInt(Stamina->GetStaminaPercentage() * 100.0f));
+
+    // A change under the threshold is held back, then sent once stamina has stopped moving
+    Stamina->StopSprinting();
+    FGameplayTestAccess::SetStaminaReplicationThreshold(Stamina, 5);
+    FGameplayTestAccess::SetStamina(Stamina, 50.0f);
+    FGameplayTestAccess::SetStamina(Stamina, 53.0f);
+    TestEqual(TEXT("Held back below the threshold"), FGameplayTestAccess::GetReplicatedStamina(Stamina).ToValue(100.0f), 50.0f, 0.01f);
+    Environment.AdvanceTimers(1.0f);
+    TestEqual(TEXT("Settles on the exact step"), FGameplayTestAccess::GetReplicatedStamina(Stamina).ToValue(100.0f), 53.0f, 0.01f);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
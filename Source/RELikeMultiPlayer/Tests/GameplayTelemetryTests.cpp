@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "../Core/Telemetry/GameplayTelemetry.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static constexpr EAutomationTestFlags GameplayTelemetryTestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayTelemetryRingTest, "RELikeMultiPlayer.Telemetry.Ring", GameplayTelemetryTestFlags)
+
+bool FGameplayTelemetryRingTest::RunTest(const FString& Parameters)
+{
+    FGameplayTelemetry& Telemetry = FGameplayTelemetry::Get();
+
+    // The ring is shared with the rest of the process, so events are told apart by Extra
+    static const int32 Marker = 0x7E1E0000;
+    FGameplayTelemetry::Record(ETelemetryEvent::Damage, nullptr, nullptr, 12.5f, Marker);
+    FGameplayTelemetry::Record(ETelemetryEvent::Heal, nullptr, nullptr, 5.0f, Marker + 1);
+
+    TArray<FTelemetryRecord> Records;
+    Telemetry.Snapshot(Records);
+    if (!TestTrue(TEXT("Events recorded"), Records.Num() >= 2)) return false;
+
+    const FTelemetryRecord& Damage = Records[Records.Num() - 2];
+    const FTelemetryRecord& Heal = Records[Records.Num() - 1];
+    TestEqual(TEXT("Oldest first"), Damage.Extra, Marker);
+    TestTrue(TEXT("Damage kept its type"), Damage.Type == ETelemetryEvent::Damage);
+    TestEqual(TEXT("Damage kept its value"), Damage.Value, 12.5f);
+    TestEqual(TEXT("No actor"), Damage.ActorId, FGameplayTelemetry::NoActor);
+    TestEqual(TEXT("Newest last"), Heal.Extra, Marker + 1);
+    TestTrue(TEXT("Timestamps in order"), Heal.Cycles >= Damage.Cycles);
+
+    // Writers on every worker, lapping the ring twice
+    static const int32 NumWriters = 8;
+    static const int32 EventsPerWriter = FGameplayTelemetry::Capacity / 4;
+    ParallelFor(NumWriters, [](int32 Writer)
+    {
+        for (int32 i = 0; i < EventsPerWriter; i++)
+        {
+            FGameplayTelemetry::Record(ETelemetryEvent::ItemUsed, nullptr, nullptr, float(i), Marker + 2 + Writer);
+        }
+    });
+
+    Telemetry.Snapshot(Records);
+    TestTrue(TEXT("Never more than the capacity"), Records.Num() <= FGameplayTelemetry::Capacity);
+    TestTrue(TEXT("Most of the ring readable after the writers finish"), Records.Num() > FGameplayTelemetry::Capacity / 2);
+
+    int32 NumTorn = 0;
+    for (const FTelemetryRecord& Record : Records)
+    {
+        const bool bFromWriter = Record.Type == ETelemetryEvent::ItemUsed && Record.Extra >= Marker + 2 && Record.Extra < Marker + 2 + NumWriters;
+        NumTorn += bFromWriter ? 0 : 1;
+    }
+    TestEqual(TEXT("Only whole records from the writers"), NumTorn, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayTelemetryDumpTest, "RELikeMultiPlayer.Telemetry.DumpRoundTrip", GameplayTelemetryTestFlags)
+
+bool FGameplayTelemetryDumpTest::RunTest(const FString& Parameters)
+{
+    TArray<FTelemetryRecord> Records;
+    FTelemetryRecord& Damage = Records.AddDefaulted_GetRef();
+    Damage.Cycles = 1000;
+    Damage.Frame = 7;
+    Damage.ActorId = 42;
+    Damage.ActorSerial = 5;
+    Damage.OtherId = 43;
+    Damage.OtherSerial = 6;
+    Damage.Value = 25.0f;
+    Damage.Extra = 3;
+    Damage.Type = ETelemetryEvent::Damage;
+
+    FTelemetryRecord& Downed = Records.AddDefaulted_GetRef();
+    Downed.Cycles = 2000;
+    Downed.ActorId = 42;
+    Downed.OtherId = FGameplayTelemetry::NoActor;
+    Downed.Type = ETelemetryEvent::Downed;
+
+    TMap<uint64, FString> ActorNames;
+    ActorNames.Add(FGameplayTelemetry::MakeObjectKey(42, 5), TEXT("Player_0"));
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    FGameplayTelemetry::WriteDump(Writer, Records, ActorNames);
+
+    FTelemetryDump Dump;
+    FMemoryReader Reader(Bytes);
+    if (!TestTrue(TEXT("Dump reads back"), FGameplayTelemetry::ReadDump(Reader, Dump))) return false;
+
+    TestEqual(TEXT("Record count"), Dump.Records.Num(), 2);
+    TestEqual(TEXT("Cycles"), Dump.Records[0].Cycles, uint64(1000));
+    TestEqual(TEXT("Frame"), Dump.Records[0].Frame, uint32(7));
+    TestEqual(TEXT("Other"), Dump.Records[0].OtherId, uint32(43));
+    TestEqual(TEXT("Value"), Dump.Records[0].Value, 25.0f);
+    TestEqual(TEXT("Hits"), Dump.Records[0].Extra, 3);
+    TestTrue(TEXT("Type"), Dump.Records[1].Type == ETelemetryEvent::Downed);
+    TestEqual(TEXT("Serial"), Dump.Records[0].OtherSerial, 6);
+    const FString* ActorName = Dump.FindActorName(42, 5);
+    TestEqual(TEXT("Actor names"), ActorName ? *ActorName : FString(), FString(TEXT("Player_0")));
+    TestNull(TEXT("A reused index does not inherit the name"), Dump.FindActorName(42, 9));
+    TestTrue(TEXT("Clock rate stored"), Dump.SecondsPerCycle > 0.0);
+
+    // Anything else is rejected rather than misread
+    Bytes[0] ^= 0xFF;
+    FTelemetryDump Corrupt;
+    FMemoryReader CorruptReader(Bytes);
+    TestFalse(TEXT("Bad magic rejected"), FGameplayTelemetry::ReadDump(CorruptReader, Corrupt));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
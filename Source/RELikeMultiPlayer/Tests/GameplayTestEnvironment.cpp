@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameplayTestEnvironment.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "../Components/Inventory/InventoryComponent.h"
+#include "../Components/Health/HealthComponent.h"
+#include "../Components/Stamina/StaminaComponent.h"
+#include "../Components/Combat/LagCompensationComponent.h"
+#include "../Items/Registry/ItemRegistrySubsystem.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "HAL/MemoryBase.h"
+#include "Net/Core/PropertyConditions/PropertyConditions.h"
+#include "UObject/CoreNet.h"
+#include <atomic>
+
+const TCHAR* FGameplayTestEnvironment::StackableItemID = TEXT("test_ammo");
+const TCHAR* FGameplayTestEnvironment::UniqueItemID = TEXT("test_key");
+const TCHAR* FGameplayTestEnvironment::MedicalItemID = TEXT("test_bandage");
+const TCHAR* FGameplayTestEnvironment::StaminaItemID = TEXT("test_energy");
+const TCHAR* FGameplayTestEnvironment::HerbItemID = TEXT("test_herb");
+const TCHAR* FGameplayTestEnvironment::LongItemID = TEXT("test_rifle");
+
+namespace
+{
+    FItemData MakeItemRow(const TCHAR* ItemID, EItemCategory Category, bool bStackable, int32 MaxStackSize)
+    {
+        FItemData Row;
+        Row.ItemID = ItemID;
+        Row.ItemName = ItemID;
+        Row.Category = Category;
+        Row.bStackable = bStackable;
+        Row.MaxStackSize = MaxStackSize;
+        return Row;
+    }
+}
+
+FGameplayTestEnvironment::FGameplayTestEnvironment()
+{
+    ItemTable = NewObject<UDataTable>(GetTransientPackage());
+    ItemTable->RowStruct = FItemData::StaticStruct();
+    ItemTable->AddRow(StackableItemID, MakeItemRow(StackableItemID, EItemCategory::Resources, true, 30));
+    FItemData KeyRow = MakeItemRow(UniqueItemID, EItemCategory::Tools, false, 1);
+    KeyRow.bIsKeyItem = true;
+    ItemTable->AddRow(UniqueItemID, KeyRow);
+    ItemTable->AddRow(MedicalItemID, MakeItemRow(MedicalItemID, EItemCategory::Medical, true, 5));
+
+    FItemData EnergyRow = MakeItemRow(StaminaItemID, EItemCategory::Resources, true, 5);
+    EnergyRow.EffectType = EItemEffectType::RestoreStamina;
+    EnergyRow.EffectMagnitude = 40.0f;
+    ItemTable->AddRow(StaminaItemID, EnergyRow);
+
+    // Two herbs and one energy drink make two bandages
+    FItemData HerbRow = MakeItemRow(HerbItemID, EItemCategory::Medical, true, 5);
+    FItemCombineRecipe& HerbRecipe = HerbRow.CombineRecipes.AddDefaulted_GetRef();
+    HerbRecipe.OtherItemID = StaminaItemID;
+    HerbRecipe.Quantity = 2;
+    HerbRecipe.OtherQuantity = 1;
+    HerbRecipe.ResultItemID = MedicalItemID;
+    HerbRecipe.ResultQuantity = 2;
+    ItemTable->AddRow(HerbItemID, HerbRow);
+
+    FItemData RifleRow = MakeItemRow(LongItemID, EItemCategory::Weapons, false, 1);
+    RifleRow.GridWidth = 3;
+    RifleRow.GridHeight = 1;
+    ItemTable->AddRow(LongItemID, RifleRow);
+    ItemTable->AddToRoot();
+
+    GameInstance = NewObject<UGameInstance>(GEngine);
+    GameInstance->AddToRoot();
+    GameInstance->InitializeStandalone(TEXT("GameplayTestWorld"));
+    World = GameInstance->GetWorld();
+
+    // Tests must not depend on whatever DT_Items contains
+    if (UItemRegistrySubsystem* Registry = GameInstance->GetSubsystem<UItemRegistrySubsystem>())
+    {
+        Registry->RebuildForTesting(ItemTable);
+    }
+}
+
+FGameplayTestEnvironment::~FGameplayTestEnvironment()
+{
+    GameInstance->Shutdown();
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    GameInstance->RemoveFromRoot();
+    ItemTable->RemoveFromRoot();
+}
+
+AActor* FGameplayTestEnvironment::SpawnActor()
+{
+    return World->SpawnActor<AActor>();
+}
+
+void FGameplayTestEnvironment::BeginPlay(AActor* Actor)
+{
+    Actor->DispatchBeginPlay();
+}
+
+void FGameplayTestEnvironment::AdvanceTimers(float Seconds)
+{
+    World->GetTimerManager().Tick(Seconds);
+}
+
+void FGameplayTestAccess::SetInventorySize(UInventoryComponent* Inventory, int32 Columns, int32 Rows)
+{
+    Inventory->InventoryColumns = Columns;
+    Inventory->InventoryRows = Rows;
+}
+
+void FGameplayTestAccess::SetGridLayout(UInventoryComponent* Inventory, int32 Columns, int32 Rows)
+{
+    SetInventorySize(Inventory, Columns, Rows);
+    Inventory->bUseGridLayout = true;
+}
+
+void FGameplayTestAccess::SetReplicateSlotsToOwnerOnly(UInventoryComponent* Inventory, bool bOwnerOnly)
+{
+    Inventory->bReplicateSlotsToOwnerOnly = bOwnerOnly;
+}
+
+namespace
+{
+    // The condition a COND_Dynamic property was given at runtime, as the replication system will apply it
+    ELifetimeCondition GetDynamicCondition(const UObject* Object, uint16 RepIndex)
+    {
+        TSharedPtr<FRepChangedPropertyTracker> Tracker = UE::Net::Private::FNetPropertyConditionManager::Get().FindPropertyTracker(Object);
+        return Tracker ? Tracker->GetDynamicCondition(RepIndex) : COND_Max;
+    }
+}
+
+ELifetimeCondition FGameplayTestAccess::GetSlotsCondition(const UInventoryComponent* Inventory)
+{
+    return GetDynamicCondition(Inventory, (uint16)UInventoryComponent::ENetFields_Private::Inventory);
+}
+
+ELifetimeCondition FGameplayTestAccess::GetAttributesCondition(const UInventoryComponent* Inventory)
+{
+    return GetDynamicCondition(Inventory, (uint16)UInventoryComponent::ENetFields_Private::Attributes);
+}
+
+int32 FGameplayTestAccess::ReceiveClientOps(UInventoryComponent* Inventory, const TArray<FInventoryOp>& Ops, int32 PredictionKey)
+{
+    Inventory->Server_ApplyInventoryOps_Implementation(Ops, PredictionKey);
+    return Inventory->LastProcessedPredictionKey;
+}
+
+void FGameplayTestAccess::ReceiveClientTransfer(UInventoryComponent* Inventory, int32 SlotIndex, UInventoryComponent* Target, int32 Quantity)
+{
+    Inventory->Server_TransferItem_Implementation(SlotIndex, Target, Quantity);
+}
+
+int32 FGameplayTestAccess::GetSlotPayloadBytes(const UInventoryComponent* Inventory, int32 SlotIndex)
+{
+    // What NetSerialize puts on the wire for the slot, without the fast array's per-item header
+    FInventorySlot Slot = Inventory->Inventory.Slots[SlotIndex];
+    FNetBitWriter Writer(nullptr, 256);
+    bool bSuccess = false;
+    Slot.NetSerialize(Writer, nullptr, bSuccess);
+    return Writer.GetNumBytes();
+}
+
+void FGameplayTestAccess::SetHealth(UHealthComponent* Health, float NewHealth)
+{
+    Health->CurrentHealth = NewHealth;
+    Health->bIsDowned = false;
+    Health->UpdateHealthState();
+}
+
+void FGameplayTestAccess::SetStamina(UStaminaComponent* Stamina, float NewStamina)
+{
+    Stamina->CurrentStamina = NewStamina;
+    Stamina->bIsExhausted = false;
+    Stamina->bCanRegenerate = true;
+    Stamina->UpdateStaminaState();
+}
+
+void FGameplayTestAccess::SetStaminaReplicationThreshold(UStaminaComponent* Stamina, int32 Threshold)
+{
+    Stamina->ReplicationThreshold = Threshold;
+}
+
+void FGameplayTestAccess::TickStamina(UStaminaComponent* Stamina, float DeltaTime)
+{
+    Stamina->TickComponent(DeltaTime, LEVELTICK_All, &Stamina->PrimaryComponentTick);
+}
+
+const FQuantizedVital& FGameplayTestAccess::GetReplicatedStamina(const UStaminaComponent* Stamina)
+{
+    return Stamina->ReplicatedStamina;
+}
+
+void FGameplayTestAccess::ConfirmHitAt(ULagCompensationComponent* Shooter, AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, double HitTime)
+{
+    Shooter->ProcessHit(Target, TraceStart, TraceEnd, HitTime);
+}
+
+namespace
+{
+    // Malloc and Realloc calls made by any thread, counted by the allocator itself. GMalloc is never replaced.
+    uint64 GetTotalAllocationCalls()
+    {
+        return FMalloc::TotalMallocCalls.load(std::memory_order_relaxed) + FMalloc::TotalReallocCalls.load(std::memory_order_relaxed);
+    }
+}
+
+FScopedAllocationCounter::FScopedAllocationCounter()
+    : StartCount(GetTotalAllocationCalls())
+{
+}
+
+uint64 FScopedAllocationCounter::GetCount() const
+{
+    return GetTotalAllocationCalls() - StartCount;
+}
+
+FBenchmarkResult RunBenchmark(int32 NumOps, TFunctionRef<void()> Setup, TFunctionRef<void(int32)> Body)
+{
+    Setup();
+    for (int32 i = 0; i < NumOps; i++)
+    {
+        Body(i);
+    }
+
+    Setup();
+    FBenchmarkResult Result;
+    {
+        FScopedAllocationCounter AllocationCounter;
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 i = 0; i < NumOps; i++)
+        {
+            Body(i);
+        }
+        const uint64 EndCycles = FPlatformTime::Cycles64();
+
+        Result.NsPerOp = FPlatformTime::ToMilliseconds64(EndCycles - StartCycles) * 1000000.0 / FMath::Max(1, NumOps);
+        Result.AllocsPerOp = double(AllocationCounter.GetCount()) / FMath::Max(1, NumOps);
+    }
+    return Result;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GameFramework/Actor.h"
+#include "Templates/Function.h"
+#include "UObject/CoreNetTypes.h"
+
+class UGameInstance;
+class UWorld;
+class UDataTable;
+class UInventoryComponent;
+class UHealthComponent;
+class UStaminaComponent;
+class ULagCompensationComponent;
+struct FQuantizedVital;
+struct FInventoryOp;
+
+// Headless game instance and world with a known item table, for automation tests and benchmarks.
+// Runs without a renderer, e.g. with -nullrhi.
+class FGameplayTestEnvironment
+{
+public:
+    FGameplayTestEnvironment();
+    ~FGameplayTestEnvironment();
+
+    UWorld* GetWorld() const { return World; }
+
+    // Spawns a bare actor. Add components, configure them, then call BeginPlay.
+    AActor* SpawnActor();
+    void BeginPlay(AActor* Actor);
+
+    // The world is never ticked, so timers only fire when advanced by hand
+    void AdvanceTimers(float Seconds);
+
+    template<typename ComponentType>
+    ComponentType* AddComponent(AActor* Actor)
+    {
+        ComponentType* Component = NewObject<ComponentType>(Actor);
+        Component->RegisterComponent();
+        Actor->AddInstanceComponent(Component);
+        return Component;
+    }
+
+    // Rows of the test item table
+    static const TCHAR* StackableItemID;    // Resources, stacks to 30
+    static const TCHAR* UniqueItemID;       // Tools, not stackable
+    static const TCHAR* MedicalItemID;      // Medical, stacks to 5
+    static const TCHAR* StaminaItemID;      // Resources, stacks to 5, restores 40 stamina
+    static const TCHAR* HerbItemID;         // Medical, stacks to 5, 2 herbs + 1 energy = 2 bandages
+    static const TCHAR* LongItemID;         // Weapons, not stackable, 3x1 cells
+
+private:
+    UGameInstance* GameInstance = nullptr;
+    UWorld* World = nullptr;
+    UDataTable* ItemTable = nullptr;
+};
+
+// Component internals the tests need to set up scenarios
+struct FGameplayTestAccess
+{
+    static void SetInventorySize(UInventoryComponent* Inventory, int32 Columns, int32 Rows);
+    static void SetGridLayout(UInventoryComponent* Inventory, int32 Columns, int32 Rows);
+    static void SetReplicateSlotsToOwnerOnly(UInventoryComponent* Inventory, bool bOwnerOnly);
+    static ELifetimeCondition GetSlotsCondition(const UInventoryComponent* Inventory);
+    static ELifetimeCondition GetAttributesCondition(const UInventoryComponent* Inventory);
+    // Runs a client's batch through the server RPC and returns the prediction key the server acknowledged
+    static int32 ReceiveClientOps(UInventoryComponent* Inventory, const TArray<FInventoryOp>& Ops, int32 PredictionKey);
+    static void ReceiveClientTransfer(UInventoryComponent* Inventory, int32 SlotIndex, UInventoryComponent* Target, int32 Quantity);
+    static int32 GetSlotPayloadBytes(const UInventoryComponent* Inventory, int32 SlotIndex);
+    static void SetHealth(UHealthComponent* Health, float NewHealth);
+    static void SetStamina(UStaminaComponent* Stamina, float NewStamina);
+    static void SetStaminaReplicationThreshold(UStaminaComponent* Stamina, int32 Threshold);
+    static void TickStamina(UStaminaComponent* Stamina, float DeltaTime);
+    static const FQuantizedVital& GetReplicatedStamina(const UStaminaComponent* Stamina);
+    // Processes a hit the way the server does for a client that fired at HitTime
+    static void ConfirmHitAt(ULagCompensationComponent* Shooter, AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, double HitTime);
+};
+
+// Counts heap allocations made while in scope, read from the allocator's call counters.
+// The counters are process wide, so the count is an upper bound: the test world is never ticked,
+// but engine worker threads may still allocate now and then.
+class FScopedAllocationCounter
+{
+public:
+    FScopedAllocationCounter();
+
+    uint64 GetCount() const;
+
+private:
+    uint64 StartCount;
+};
+
+struct FBenchmarkResult
+{
+    double NsPerOp = 0.0;
+    double AllocsPerOp = 0.0;
+};
+
+// Runs Setup then NumOps calls of Body once untimed to warm caches and containers,
+// then again timed while counting allocations. Setup is never measured.
+FBenchmarkResult RunBenchmark(int32 NumOps, TFunctionRef<void()> Setup, TFunctionRef<void(int32)> Body);
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "../Components/Inventory/InventoryModel.h"
+#include "Misc/AutomationTest.h"
+
+// The model needs no world, game instance or item registry, so these run as plain unit tests
+static constexpr EAutomationTestFlags InventoryModelTestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+namespace
+{
+    enum : int32 { Ammo, Key, Rifle };
+
+    const FInventoryModelItem ModelItems[] =
+    {
+        { true, 30, FIntPoint(1, 1) },
+        { false, 1, FIntPoint(1, 1) },
+        { false, 1, FIntPoint(3, 1) },
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryModelStackingTest, "RELikeMultiPlayer.InventoryModel.Stacking", InventoryModelTestFlags)
+
+bool FInventoryModelStackingTest::RunTest(const FString& Parameters)
+{
+    FInventoryModel Model;
+    Model.Reset(2, 2, false, ModelItems);
+
+    TestTrue(TEXT("Add 45 ammo"), Model.Add(Ammo, 45));
+    TestEqual(TEXT("First stack full"), Model.GetSlot(0).Quantity, 30);
+    TestEqual(TEXT("Second stack partial"), Model.GetSlot(1).Quantity, 15);
+    TestEqual(TEXT("Room left"), Model.GetAddableQuantity(Ammo), 15 + 2 * 30);
+
+    TestFalse(TEXT("More than fits"), Model.Add(Ammo, 76));
+    TestEqual(TEXT("Failed add changes nothing"), Model.GetTotalQuantity(Ammo), 45);
+
+    TestTrue(TEXT("Add a key"), Model.Add(Key, 1));
+    TestTrue(TEXT("Move the partial stack"), Model.Move(1, 3, 15));
+    TestTrue(TEXT("Swap key and full stack"), Model.Swap(0, 2));
+    TestEqual(TEXT("Key in slot 0"), Model.GetSlot(0).ItemIndex, int32(Key));
+    TestTrue(TEXT("Remove ammo"), Model.Remove(3, 15));
+    TestTrue(TEXT("Emptied slot"), Model.GetSlot(3).IsEmpty());
+    TestFalse(TEXT("Different items do not merge"), Model.Move(0, 2, 1));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryModelTransferTest, "RELikeMultiPlayer.InventoryModel.Transfer", InventoryModelTestFlags)
+
+bool FInventoryModelTransferTest::RunTest(const FString& Parameters)
+{
+    FInventoryModel Source;
+    Source.Reset(2, 1, false, ModelItems);
+    FInventoryModel Target;
+    Target.Reset(1, 1, false, ModelItems);
+
+    int32 NumWrites = 0;
+    Target.OnSlotWritten = [&NumWrites](int32) { NumWrites++; };
+
+    TestTrue(TEXT("Fill the source"), Source.Add(Ammo, 40));
+    TestTrue(TEXT("Partly fill the target"), Target.Add(Ammo, 20));
+    TestFalse(TEXT("Transfer larger than the target's room"), FInventoryModel::Transfer(Source, 0, Target, 30));
+    TestEqual(TEXT("Source unchanged"), Source.GetTotalQuantity(Ammo), 40);
+    TestEqual(TEXT("Target unchanged"), Target.GetTotalQuantity(Ammo), 20);
+
+    int32 TargetSlot = INDEX_NONE;
+    TestTrue(TEXT("Transfer that fits"), FInventoryModel::Transfer(Source, 1, Target, 10, &TargetSlot));
+    TestEqual(TEXT("Merged into the target stack"), TargetSlot, 0);
+    TestEqual(TEXT("Source after"), Source.GetTotalQuantity(Ammo), 30);
+    TestEqual(TEXT("Target after"), Target.GetTotalQuantity(Ammo), 30);
+    TestEqual(TEXT("Listener saw each write"), NumWrites, 2);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryModelGridTest, "RELikeMultiPlayer.InventoryModel.GridLayout", InventoryModelTestFlags)
+
+bool FInventoryModelGridTest::RunTest(const FString& Parameters)
+{
+    FInventoryModel Model;
+    Model.Reset(3, 2, true, ModelItems);
+
+    TestEqual(TEXT("Two rifles fit a 3x2 grid"), Model.GetAddableQuantity(Rifle), 2);
+    TestTrue(TEXT("Add a rifle"), Model.Add(Rifle, 1));
+    TestFalse(TEXT("No anchor for a key over the rifle"), Model.CanPlace(1, Key, false));
+    TestTrue(TEXT("Key fits below"), Model.CanPlace(4, Key, false));
+    TestFalse(TEXT("Rotated rifle does not fit in two rows"), Model.Rotate(0));
+    TestFalse(TEXT("Three rifles do not fit"), Model.Add(Rifle, 2));
+    TestEqual(TEXT("Failed grid add changes nothing"), Model.GetTotalQuantity(Rifle), 1);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS